@@ -32,7 +32,9 @@ FGuid UUINavAsyncHelpers::LoadUINavWidgetAsync(
 		bRemoveParent,
 		bDestroyParent,
 		ZOrder,
-		Priority
+		Priority,
+		false, // bLoadDependencies
+		UUINavAsyncWidgetManager::FindPlayerController(WorldContext)
 	);
 }
 
@@ -82,7 +84,9 @@ FGuid UUINavAsyncHelpers::LoadUINavWidgetAsyncWithCallbacks(
 		bRemoveParent,
 		bDestroyParent,
 		ZOrder,
-		Priority
+		Priority,
+		false, // bLoadDependencies
+		UUINavAsyncWidgetManager::FindPlayerController(WorldContext)
 	);
 }
 
@@ -125,7 +129,9 @@ FGuid UUINavAsyncHelpers::PreloadUINavWidget(
 		false, // bRemoveParent
 		false, // bDestroyParent
 		0,     // ZOrder
-		Priority
+		Priority,
+		false, // bLoadDependencies
+		UUINavAsyncWidgetManager::FindPlayerController(WorldContext)
 	);
 }
 
@@ -268,14 +274,16 @@ FGuid UUINavAsyncHelpers::LoadUINavWidgetAsyncWithEvents(
 		bRemoveParent,
 		bDestroyParent,
 		ZOrder,
-		Priority
+		Priority,
+		false, // bLoadDependencies
+		UUINavAsyncWidgetManager::FindPlayerController(WorldContext)
 	);
 }
 
 void UUINavAsyncHelpers::GetCacheStatistics(
 	UObject* WorldContext,
 	int32& CachedWidgetClasses,
-	int32& TotalCacheSize)
+	int64& TotalCacheSize)
 {
 	UUINavAsyncWidgetManager* AsyncManager = UUINavAsyncWidgetManager::GetInstance(WorldContext);
 	if (!AsyncManager)
@@ -289,10 +297,26 @@ void UUINavAsyncHelpers::GetCacheStatistics(
 	AsyncManager->GetCacheStatistics(CachedWidgetClasses, TotalCacheSize);
 }
 
+void UUINavAsyncHelpers::SetUINavWidgetClassPinned(
+	UObject* WorldContext,
+	TSoftClassPtr<UUINavWidget> WidgetClass,
+	bool bPinned)
+{
+	UUINavAsyncWidgetManager* AsyncManager = UUINavAsyncWidgetManager::GetInstance(WorldContext);
+	if (!AsyncManager)
+	{
+		UINAV_LOG("SetUINavWidgetClassPinned: Failed to get AsyncWidgetManager instance");
+		return;
+	}
+
+	AsyncManager->SetWidgetClassPinned(WidgetClass, bPinned);
+}
+
 FGuid UUINavAsyncHelpers::PreloadUINavWidgetClass(
 	UObject* WorldContext,
 	TSoftClassPtr<UUINavWidget> WidgetClass,
-	int32 Priority)
+	int32 Priority,
+	bool bLoadDependencies)
 {
 	UUINavAsyncWidgetManager* AsyncManager = UUINavAsyncWidgetManager::GetInstance(WorldContext);
 	if (!AsyncManager)
@@ -301,7 +325,7 @@ FGuid UUINavAsyncHelpers::PreloadUINavWidgetClass(
 		return FGuid();
 	}
 
-	return AsyncManager->PreloadWidgetClass(WidgetClass, Priority);
+	return AsyncManager->PreloadWidgetClass(WidgetClass, Priority, bLoadDependencies);
 }
 
 bool UUINavAsyncHelpers::IsUINavWidgetClassCached(
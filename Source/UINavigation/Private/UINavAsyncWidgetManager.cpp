@@ -6,13 +6,20 @@
 #include "UINavMacros.h"
 #include "Engine/World.h"
 #include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Components/ActorComponent.h"
 #include "TimerManager.h"
+#include "HAL/IConsoleManager.h"
 #include "Blueprint/UserWidget.h"
 #include "Kismet/GameplayStatics.h"
 #include "UObject/ConstructorHelpers.h"
-
-// 静态实例初始化
-UUINavAsyncWidgetManager* UUINavAsyncWidgetManager::Instance = nullptr;
+#include "UObject/Package.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/AssetData.h"
+#include "Misc/PackageName.h"
 
 UUINavAsyncWidgetManager::UUINavAsyncWidgetManager()
 {
@@ -28,39 +35,76 @@ UUINavAsyncWidgetManager::UUINavAsyncWidgetManager()
 	CancelledRequestCount = 0;
 }
 
+void UUINavAsyncWidgetManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// 启动清理定时器
+	if (FTimerManager* const TimerManager = GetTimerManager())
+	{
+		TimerManager->SetTimer(
+			CleanupTimerHandle,
+			this,
+			&UUINavAsyncWidgetManager::CleanupCompletedRequests,
+			CleanupInterval,
+			true
+		);
+	}
+
+	UINAV_LOG("UINavAsyncWidgetManager initialized for %s", *GetGameInstance()->GetName());
+}
+
+void UUINavAsyncWidgetManager::Deinitialize()
+{
+	// 取消所有请求并释放缓存，避免加载回调或资源泄漏到下一个GameInstance
+	CancelAllLoadRequests();
+
+	PinnedWidgetClasses.Empty();
+	ClearCache();
+
+	if (FTimerManager* const TimerManager = GetTimerManager())
+	{
+		TimerManager->ClearTimer(CleanupTimerHandle);
+	}
+
+	Super::Deinitialize();
+}
+
 UUINavAsyncWidgetManager* UUINavAsyncWidgetManager::GetInstance(UObject* WorldContext)
 {
-	if (!Instance)
+	const UGameInstance* const GameInstance = UGameplayStatics::GetGameInstance(WorldContext);
+	return IsValid(GameInstance) ? GameInstance->GetSubsystem<UUINavAsyncWidgetManager>() : nullptr;
+}
+
+APlayerController* UUINavAsyncWidgetManager::FindPlayerController(const UObject* WorldContext)
+{
+	if (const APlayerController* const PlayerController = Cast<APlayerController>(WorldContext))
 	{
-		Instance = NewObject<UUINavAsyncWidgetManager>(GetTransientPackage());
-		Instance->AddToRoot(); // 防止被垃圾回收
-		
-		// 设置世界上下文
-		if (WorldContext)
-		{
-			Instance->WorldContext = WorldContext->GetWorld();
-		}
-		else if (GEngine && GEngine->GetCurrentPlayWorld())
-		{
-			Instance->WorldContext = GEngine->GetCurrentPlayWorld();
-		}
+		return const_cast<APlayerController*>(PlayerController);
+	}
 
-		// 启动清理定时器
-		if (Instance->WorldContext.IsValid())
-		{
-			Instance->WorldContext->GetTimerManager().SetTimer(
-				Instance->CleanupTimerHandle,
-				Instance,
-				&UUINavAsyncWidgetManager::CleanupCompletedRequests,
-				Instance->CleanupInterval,
-				true
-			);
-		}
+	if (const UUserWidget* const UserWidget = Cast<UUserWidget>(WorldContext))
+	{
+		return UserWidget->GetOwningPlayer();
+	}
+
+	if (const UActorComponent* const Component = Cast<UActorComponent>(WorldContext))
+	{
+		WorldContext = Component->GetOwner();
+	}
 
-		UINAV_LOG("UINavAsyncWidgetManager instance created");
+	if (const APawn* const Pawn = Cast<APawn>(WorldContext))
+	{
+		return Cast<APlayerController>(Pawn->GetController());
 	}
 
-	return Instance;
+	return Cast<APlayerController>(const_cast<UObject*>(WorldContext));
+}
+
+FTimerManager* UUINavAsyncWidgetManager::GetTimerManager() const
+{
+	const UGameInstance* const GameInstance = Cast<UGameInstance>(GetOuter());
+	return IsValid(GameInstance) ? &GameInstance->GetTimerManager() : nullptr;
 }
 
 FGuid UUINavAsyncWidgetManager::LoadWidgetAsync(
@@ -70,7 +114,9 @@ FGuid UUINavAsyncWidgetManager::LoadWidgetAsync(
 	bool bRemoveParent,
 	bool bDestroyParent,
 	int32 ZOrder,
-	int32 Priority)
+	int32 Priority,
+	bool bLoadDependencies,
+	APlayerController* OwningPlayer)
 {
 	if (WidgetClass.IsNull())
 	{
@@ -89,32 +135,29 @@ FGuid UUINavAsyncWidgetManager::LoadWidgetAsync(
 	NewRequest.bDestroyParent = bDestroyParent;
 	NewRequest.ZOrder = ZOrder;
 	NewRequest.Priority = Priority;
+	NewRequest.bLoadDependencies = bLoadDependencies;
 	NewRequest.OnLoadCompleted = OnLoadCompleted;
+	NewRequest.OwningPlayer = IsValid(OwningPlayer) ? OwningPlayer->GetLocalPlayer() : GetGameInstance()->GetFirstGamePlayer();
 	NewRequest.OnLoadFailed = OnLoadFailed;
 
+	const FGuid RequestId = NewRequest.RequestId;
+
 	TotalRequestCount++;
 
-	UINAV_LOG("LoadWidgetAsync: Requesting load for %s (ID: %s, Priority: %d)", 
-		*WidgetClass.GetAssetName(), 
-		*NewRequest.RequestId.ToString(), 
+	UINAV_LOG("LoadWidgetAsync: Requesting load for %s (ID: %s, Priority: %d)",
+		*WidgetClass.GetAssetName(),
+		*RequestId.ToString(),
 		Priority);
 
-	// 如果有空闲槽位，直接开始加载
-	if (ActiveRequests.Num() < MaxConcurrentLoads)
-	{
-		ActiveRequests.Add(NewRequest);
-		StartLoadingWidget(NewRequest);
-	}
-	else
+	// 同一Widget类正在加载时共享该加载，否则加入等待队列
+	SubmitRequest(MoveTemp(NewRequest));
+
+	if (PendingRequests.Contains(RequestId))
 	{
-		// 添加到等待队列并按优先级排序
-		PendingRequests.Add(NewRequest);
-		PendingRequests.Sort();
-		
 		UINAV_LOG("LoadWidgetAsync: Request queued (Queue size: %d)", PendingRequests.Num());
 	}
 
-	return NewRequest.RequestId;
+	return RequestId;
 }
 
 bool UUINavAsyncWidgetManager::CancelLoadRequest(const FGuid& RequestId)
@@ -124,58 +167,41 @@ bool UUINavAsyncWidgetManager::CancelLoadRequest(const FGuid& RequestId)
 		return false;
 	}
 
+	FAsyncWidgetLoadRequest CancelledRequest;
+
 	// 检查活跃请求
-	for (int32 i = 0; i < ActiveRequests.Num(); ++i)
+	if (RemoveActiveRequest(RequestId, CancelledRequest))
 	{
-		if (ActiveRequests[i].RequestId == RequestId)
+		UINAV_LOG("CancelLoadRequest: Cancelling active request %s", *RequestId.ToString());
+
+		CancelledRequestIds.Add(RequestId);
+		CancelledRequestCount++;
+
+		// 只有共享加载的最后一个订阅者被取消时，才取消加载本身
+		FInFlightWidgetLoad* const InFlightLoad = InFlightLoads.Find(CancelledRequest.WidgetClass);
+		if (InFlightLoad != nullptr)
 		{
-			UINAV_LOG("CancelLoadRequest: Cancelling active request %s", *RequestId.ToString());
-			
-			// 取消Streamable句柄
-			if (TSharedPtr<FStreamableHandle>* HandlePtr = ActiveHandles.Find(RequestId))
+			InFlightLoad->RequestIds.Remove(RequestId);
+			if (InFlightLoad->RequestIds.Num() == 0)
 			{
-				if (HandlePtr->IsValid())
-				{
-					(*HandlePtr)->CancelHandle();
-				}
-				ActiveHandles.Remove(RequestId);
-			}
+				FInFlightWidgetLoad CancelledLoad;
+				RemoveInFlightLoad(CancelledRequest.WidgetClass, CancelledLoad, true);
 
-			// 清除超时定时器
-			if (FTimerHandle* TimeoutHandle = TimeoutHandles.Find(RequestId))
-			{
-				if (WorldContext.IsValid())
-				{
-					WorldContext->GetTimerManager().ClearTimer(*TimeoutHandle);
-				}
-				TimeoutHandles.Remove(RequestId);
+				// 处理下一个请求
+				ProcessPendingRequests();
 			}
-
-			// 标记为已取消并移除
-			ActiveRequests[i].bCancelled = true;
-			CancelledRequestIds.Add(RequestId);
-			ActiveRequests.RemoveAt(i);
-			CancelledRequestCount++;
-
-			// 处理下一个请求
-			ProcessNextRequest();
-			return true;
 		}
+		return true;
 	}
 
 	// 检查等待队列
-	for (int32 i = 0; i < PendingRequests.Num(); ++i)
+	if (RemovePendingRequest(RequestId, CancelledRequest))
 	{
-		if (PendingRequests[i].RequestId == RequestId)
-		{
-			UINAV_LOG("CancelLoadRequest: Cancelling pending request %s", *RequestId.ToString());
-			
-			PendingRequests[i].bCancelled = true;
-			CancelledRequestIds.Add(RequestId);
-			PendingRequests.RemoveAt(i);
-			CancelledRequestCount++;
-			return true;
-		}
+		UINAV_LOG("CancelLoadRequest: Cancelling pending request %s", *RequestId.ToString());
+
+		CancelledRequestIds.Add(RequestId);
+		CancelledRequestCount++;
+		return true;
 	}
 
 	return false;
@@ -186,35 +212,29 @@ void UUINavAsyncWidgetManager::CancelAllLoadRequests()
 	UINAV_LOG("CancelAllLoadRequests: Cancelling all requests");
 
 	// 取消所有活跃请求
-	for (FAsyncWidgetLoadRequest& Request : ActiveRequests)
+	for (const TPair<FGuid, FAsyncWidgetLoadRequest>& ActiveRequest : ActiveRequests)
+	{
+		CancelledRequestIds.Add(ActiveRequest.Key);
+	}
+
+	// 取消所有共享加载的Streamable句柄和超时定时器
+	for (TPair<TSoftClassPtr<UUINavWidget>, FInFlightWidgetLoad>& InFlightLoad : InFlightLoads)
 	{
-		Request.bCancelled = true;
-		CancelledRequestIds.Add(Request.RequestId);
-		
-		// 取消Streamable句柄
-		if (TSharedPtr<FStreamableHandle>* HandlePtr = ActiveHandles.Find(Request.RequestId))
+		if (InFlightLoad.Value.Handle.IsValid())
 		{
-			if (HandlePtr->IsValid())
-			{
-				(*HandlePtr)->CancelHandle();
-			}
+			InFlightLoad.Value.Handle->CancelHandle();
 		}
 
-		// 清除超时定时器
-		if (FTimerHandle* TimeoutHandle = TimeoutHandles.Find(Request.RequestId))
+		if (FTimerManager* const TimerManager = GetTimerManager())
 		{
-			if (WorldContext.IsValid())
-			{
-				WorldContext->GetTimerManager().ClearTimer(*TimeoutHandle);
-			}
+			TimerManager->ClearTimer(InFlightLoad.Value.TimeoutHandle);
 		}
 	}
 
 	// 取消所有等待请求
-	for (FAsyncWidgetLoadRequest& Request : PendingRequests)
+	for (const TPair<FGuid, FAsyncWidgetLoadRequest>& PendingRequest : PendingRequests)
 	{
-		Request.bCancelled = true;
-		CancelledRequestIds.Add(Request.RequestId);
+		CancelledRequestIds.Add(PendingRequest.Key);
 	}
 
 	CancelledRequestCount += ActiveRequests.Num() + PendingRequests.Num();
@@ -222,53 +242,70 @@ void UUINavAsyncWidgetManager::CancelAllLoadRequests()
 	// 清理所有容器
 	ActiveRequests.Empty();
 	PendingRequests.Empty();
-	ActiveHandles.Empty();
-	TimeoutHandles.Empty();
+	PlayerQueues.Empty();
+	PendingHeapIndices.Empty();
+	LoadingClassCounts.Empty();
+	InFlightLoads.Empty();
 }
 
-int32 UUINavAsyncWidgetManager::GetActiveLoadRequestCount() const
-{
-	return ActiveRequests.Num();
-}
-
-int32 UUINavAsyncWidgetManager::GetPendingLoadRequestCount() const
+int32 UUINavAsyncWidgetManager::CancelPlayerLoadRequests(APlayerController* OwningPlayer)
 {
-	return PendingRequests.Num();
-}
+	const ULocalPlayer* const LocalPlayer = IsValid(OwningPlayer) ? OwningPlayer->GetLocalPlayer() : nullptr;
+	if (LocalPlayer == nullptr)
+	{
+		return 0;
+	}
 
-bool UUINavAsyncWidgetManager::IsWidgetLoading(TSoftClassPtr<UUINavWidget> WidgetClass) const
-{
-	// 检查活跃请求
-	for (const FAsyncWidgetLoadRequest& Request : ActiveRequests)
+	TArray<FGuid> PlayerRequestIds;
+	for (const TPair<FGuid, FAsyncWidgetLoadRequest>& ActiveRequest : ActiveRequests)
 	{
-		if (Request.WidgetClass == WidgetClass && !Request.bCancelled)
+		if (ActiveRequest.Value.OwningPlayer == LocalPlayer)
 		{
-			return true;
+			PlayerRequestIds.Add(ActiveRequest.Key);
 		}
 	}
 
-	// 检查等待队列
-	for (const FAsyncWidgetLoadRequest& Request : PendingRequests)
+	if (const FPlayerRequestQueue* const Queue = PlayerQueues.Find(LocalPlayer))
 	{
-		if (Request.WidgetClass == WidgetClass && !Request.bCancelled)
+		for (const FPendingRequestEntry& PendingEntry : Queue->Heap)
 		{
-			return true;
+			PlayerRequestIds.Add(PendingEntry.RequestId);
 		}
 	}
 
-	return false;
+	int32 NumCancelled = 0;
+	for (const FGuid& RequestId : PlayerRequestIds)
+	{
+		NumCancelled += CancelLoadRequest(RequestId) ? 1 : 0;
+	}
+
+	UINAV_LOG("CancelPlayerLoadRequests: Cancelled %d requests of %s", NumCancelled, *LocalPlayer->GetName());
+	return NumCancelled;
+}
+
+int32 UUINavAsyncWidgetManager::GetActiveLoadRequestCount() const
+{
+	return ActiveRequests.Num();
+}
+
+int32 UUINavAsyncWidgetManager::GetPendingLoadRequestCount() const
+{
+	return PendingRequests.Num();
+}
+
+bool UUINavAsyncWidgetManager::IsWidgetLoading(TSoftClassPtr<UUINavWidget> WidgetClass) const
+{
+	const int32* const LoadingCount = LoadingClassCounts.Find(WidgetClass);
+	return LoadingCount != nullptr && *LoadingCount > 0;
 }
 
 void UUINavAsyncWidgetManager::SetMaxConcurrentLoads(int32 NewMaxConcurrentLoads)
 {
 	MaxConcurrentLoads = FMath::Max(1, NewMaxConcurrentLoads);
 	UINAV_LOG("SetMaxConcurrentLoads: Set to %d", MaxConcurrentLoads);
-	
+
 	// 如果增加了并发数，尝试处理更多请求
-	while (ActiveRequests.Num() < MaxConcurrentLoads && PendingRequests.Num() > 0)
-	{
-		ProcessNextRequest();
-	}
+	ProcessPendingRequests();
 }
 
 void UUINavAsyncWidgetManager::SetLoadTimeout(float TimeoutSeconds)
@@ -277,319 +314,831 @@ void UUINavAsyncWidgetManager::SetLoadTimeout(float TimeoutSeconds)
 	UINAV_LOG("SetLoadTimeout: Set to %.2f seconds", LoadTimeoutSeconds);
 }
 
-bool UUINavAsyncWidgetManager::GetRequestStatus(const FGuid& RequestId, bool& bIsActive, bool& bIsPending, bool& bIsCancelled) const
+void UUINavAsyncWidgetManager::SetDependencyLoadLimits(int32 MaxDepth, int64 MaxBytes)
 {
-	bIsActive = false;
-	bIsPending = false;
-	bIsCancelled = CancelledRequestIds.Contains(RequestId);
+	MaxDependencyDepth = FMath::Max(1, MaxDepth);
+	MaxDependencyBytes = FMath::Max<int64>(0, MaxBytes);
+	UINAV_LOG("SetDependencyLoadLimits: Depth %d, %lld bytes", MaxDependencyDepth, MaxDependencyBytes);
+}
+
+bool UUINavAsyncWidgetManager::GetRequestLoadSize(const FGuid& RequestId, int32& NumAssets, int64& NumBytes) const
+{
+	NumAssets = 0;
+	NumBytes = 0;
 
-	if (bIsCancelled)
+	if (const FRequestLoadSize* const FinishedLoadSize = FinishedLoadSizes.Find(RequestId))
 	{
+		NumAssets = FinishedLoadSize->NumAssets;
+		NumBytes = FinishedLoadSize->NumBytes;
 		return true;
 	}
 
-	// 检查活跃请求
-	for (const FAsyncWidgetLoadRequest& Request : ActiveRequests)
+	// 正在加载的请求报告其所属加载的大小
+	const FAsyncWidgetLoadRequest* const ActiveRequest = ActiveRequests.Find(RequestId);
+	const FInFlightWidgetLoad* const InFlightLoad = ActiveRequest != nullptr ? InFlightLoads.Find(ActiveRequest->WidgetClass) : nullptr;
+	if (InFlightLoad == nullptr)
 	{
-		if (Request.RequestId == RequestId)
-		{
-			bIsActive = true;
-			return true;
-		}
+		return false;
 	}
 
-	// 检查等待队列
-	for (const FAsyncWidgetLoadRequest& Request : PendingRequests)
+	NumAssets = InFlightLoad->NumAssets;
+	NumBytes = InFlightLoad->NumBytes;
+	return true;
+}
+
+bool UUINavAsyncWidgetManager::GetRequestStatus(const FGuid& RequestId, bool& bIsActive, bool& bIsPending, bool& bIsCancelled) const
+{
+	bIsCancelled = CancelledRequestIds.Contains(RequestId);
+	bIsActive = !bIsCancelled && ActiveRequests.Contains(RequestId);
+	bIsPending = !bIsCancelled && !bIsActive && PendingRequests.Contains(RequestId);
+
+	return bIsCancelled || bIsActive || bIsPending;
+}
+
+void UUINavAsyncWidgetManager::SubmitRequest(FAsyncWidgetLoadRequest&& Request)
+{
+	FInFlightWidgetLoad* const InFlightLoad = InFlightLoads.Find(Request.WidgetClass);
+	if (InFlightLoad != nullptr)
 	{
-		if (Request.RequestId == RequestId)
-		{
-			bIsPending = true;
-			return true;
-		}
+		UINAV_LOG("SubmitRequest: Attaching request %s to the in-flight load of %s",
+			*Request.RequestId.ToString(),
+			*Request.WidgetClass.GetAssetName());
+
+		AddLoadingClass(Request.WidgetClass);
+		AttachToInFlightLoad(*InFlightLoad, MoveTemp(Request));
+		return;
 	}
 
-	return false;
+	EnqueueRequest(MoveTemp(Request));
+	ProcessPendingRequests();
+}
+
+void UUINavAsyncWidgetManager::EnqueueRequest(FAsyncWidgetLoadRequest&& Request)
+{
+	const FGuid RequestId = Request.RequestId;
+	Request.SequenceNumber = NextSequenceNumber++;
+
+	TArray<FPendingRequestEntry>& Heap = PlayerQueues.FindOrAdd(Request.OwningPlayer).Heap;
+	const int32 HeapIndex = Heap.Add({ RequestId, Request.Priority, Request.SequenceNumber });
+	PendingHeapIndices.Add(RequestId, HeapIndex);
+	AddLoadingClass(Request.WidgetClass);
+	PendingRequests.Add(RequestId, MoveTemp(Request));
+
+	SiftPendingHeapUp(Heap, HeapIndex);
+}
+
+void UUINavAsyncWidgetManager::AttachToInFlightLoad(FInFlightWidgetLoad& InFlightLoad, FAsyncWidgetLoadRequest&& Request)
+{
+	const FGuid RequestId = Request.RequestId;
+	InFlightLoad.RequestIds.Add(RequestId);
+	ActiveRequests.Add(RequestId, MoveTemp(Request));
+	CoalescedRequestCount++;
 }
 
-void UUINavAsyncWidgetManager::ProcessNextRequest()
+void UUINavAsyncWidgetManager::ProcessPendingRequests()
 {
-	if (PendingRequests.Num() > 0 && ActiveRequests.Num() < MaxConcurrentLoads)
+	// 回调中发起的新请求会由外层循环继续处理
+	if (bProcessingRequests)
+	{
+		return;
+	}
+
+	TGuardValue<bool> ProcessingGuard(bProcessingRequests, true);
+
+	FPlayerRequestQueue* Queue = nullptr;
+	while ((Queue = SelectNextPlayerQueue(InFlightLoads.Num() < MaxConcurrentLoads)) != nullptr)
 	{
-		// 获取最高优先级的请求
-		FAsyncWidgetLoadRequest NextRequest = PendingRequests[0];
-		PendingRequests.RemoveAt(0);
+		Queue->LastServed = ++PlayerServeCounter;
 
-		// 检查是否已被取消
-		if (NextRequest.bCancelled || CancelledRequestIds.Contains(NextRequest.RequestId))
+		FAsyncWidgetLoadRequest NextRequest;
+		PopPendingRequest(*Queue, NextRequest);
+
+		FInFlightWidgetLoad* const InFlightLoad = InFlightLoads.Find(NextRequest.WidgetClass);
+		if (InFlightLoad != nullptr)
 		{
-			UINAV_LOG("ProcessNextRequest: Skipping cancelled request %s", *NextRequest.RequestId.ToString());
-			// 递归处理下一个请求
-			ProcessNextRequest();
-			return;
+			AttachToInFlightLoad(*InFlightLoad, MoveTemp(NextRequest));
+			continue;
 		}
 
-		ActiveRequests.Add(NextRequest);
-		StartLoadingWidget(NextRequest);
+		const FGuid RequestId = NextRequest.RequestId;
+		ActiveRequests.Add(RequestId, MoveTemp(NextRequest));
+		StartLoadingWidget(RequestId);
 	}
 }
 
-void UUINavAsyncWidgetManager::StartLoadingWidget(const FAsyncWidgetLoadRequest& Request)
+UUINavAsyncWidgetManager::FPlayerRequestQueue* UUINavAsyncWidgetManager::SelectNextPlayerQueue(const bool bHasFreeSlot)
 {
-	UINAV_LOG("StartLoadingWidget: Starting load for %s (ID: %s)", 
-		*Request.WidgetClass.GetAssetName(), 
-		*Request.RequestId.ToString());
-
-	// 首先检查缓存
-	TSubclassOf<UUINavWidget> CachedClass = GetFromWidgetClassCache(Request.WidgetClass);
-	if (CachedClass)
+	FPlayerRequestQueue* BestQueue = nullptr;
+	for (TPair<TWeakObjectPtr<ULocalPlayer>, FPlayerRequestQueue>& PlayerQueue : PlayerQueues)
 	{
-		UINAV_LOG("StartLoadingWidget: Found cached class for %s, creating widget immediately", 
-			*Request.WidgetClass.GetAssetName());
-		
-		// 直接使用缓存的类创建Widget
-		UUINavWidget* CreatedWidget = CreateAndSetupWidget(CachedClass, Request);
-		
-		if (CreatedWidget)
-		{
-			UINAV_LOG("StartLoadingWidget: Widget created successfully from cache for %s", 
-				*Request.WidgetClass.GetAssetName());
-			
-			if (Request.OnLoadCompleted.IsBound())
-			{
-				Request.OnLoadCompleted.ExecuteIfBound(CreatedWidget);
-			}
-			
-			CompletedRequestCount++;
+		FPlayerRequestQueue& Queue = PlayerQueue.Value;
+		if (Queue.Heap.Num() == 0)
+		{
+			continue;
 		}
-		else
+
+		// 已在加载中或已缓存的Widget类不占用并发槽位，可以立即处理
+		const FAsyncWidgetLoadRequest& TopRequest = PendingRequests.FindChecked(Queue.Heap[0].RequestId);
+		if (InFlightLoads.Contains(TopRequest.WidgetClass) || WidgetClassCache.Contains(TopRequest.WidgetClass))
 		{
-			UINAV_LOG("StartLoadingWidget: Failed to create widget from cache for %s", 
-				*Request.WidgetClass.GetAssetName());
-			
-			if (Request.OnLoadFailed.IsBound())
-			{
-				Request.OnLoadFailed.ExecuteIfBound(TEXT("Failed to create widget from cached class"));
-			}
-			
-			FailedRequestCount++;
+			return &Queue;
 		}
 
-		// 从活跃列表中移除
-		for (int32 i = 0; i < ActiveRequests.Num(); ++i)
+		if (!bHasFreeSlot)
 		{
-			if (ActiveRequests[i].RequestId == Request.RequestId)
-			{
-				ActiveRequests.RemoveAt(i);
-				break;
-			}
+			continue;
+		}
+
+		if (BestQueue == nullptr ||
+			Queue.NumInFlightLoads < BestQueue->NumInFlightLoads ||
+			(Queue.NumInFlightLoads == BestQueue->NumInFlightLoads && Queue.LastServed < BestQueue->LastServed))
+		{
+			BestQueue = &Queue;
 		}
+	}
+
+	return BestQueue;
+}
+
+void UUINavAsyncWidgetManager::StartLoadingWidget(const FGuid& RequestId)
+{
+	const FAsyncWidgetLoadRequest* const Request = ActiveRequests.Find(RequestId);
+	if (Request == nullptr)
+	{
+		return;
+	}
+
+	const TSoftClassPtr<UUINavWidget> WidgetClass = Request->WidgetClass;
+
+	UINAV_LOG("StartLoadingWidget: Starting load for %s (ID: %s)",
+		*WidgetClass.GetAssetName(),
+		*RequestId.ToString());
+
+	// 首先检查缓存
+	TSubclassOf<UUINavWidget> CachedClass = GetFromWidgetClassCache(WidgetClass);
+	if (CachedClass)
+	{
+		UINAV_LOG("StartLoadingWidget: Found cached class for %s, creating widget immediately",
+			*WidgetClass.GetAssetName());
 
-		// 处理下一个请求
-		ProcessNextRequest();
+		// 直接使用缓存的类创建Widget
+		FAsyncWidgetLoadRequest CompletedRequest;
+		RemoveActiveRequest(RequestId, CompletedRequest);
+		FinishedLoadSizes.Add(RequestId);
+		CompleteRequest(CompletedRequest, CachedClass);
 		return;
 	}
 
+	// 需要加载的资源，Widget类本身排在第一个
+	TArray<FSoftObjectPath> AssetPaths;
+	AssetPaths.Add(WidgetClass.ToSoftObjectPath());
+	const int64 DependencyBytes = Request->bLoadDependencies ? GatherWidgetDependencies(WidgetClass, AssetPaths) : 0;
+
 	// 缓存中没有找到，需要异步加载
+	// 之后对同一Widget类的请求都会共享这次加载
+	// 共享的加载沿用发起加载的请求的依赖设置
+	FInFlightWidgetLoad& InFlightLoad = InFlightLoads.Add(WidgetClass);
+	InFlightLoad.RequestIds.Add(RequestId);
+	InFlightLoad.OwningPlayer = Request->OwningPlayer;
+	PlayerQueues.FindOrAdd(Request->OwningPlayer).NumInFlightLoads++;
+	InFlightLoad.NumAssets = AssetPaths.Num();
+	InFlightLoad.NumBytes = DependencyBytes;
+
+	if (AssetPaths.Num() > 1)
+	{
+		UINAV_LOG("StartLoadingWidget: Loading %s with %d dependencies (%lld bytes)",
+			*WidgetClass.GetAssetName(),
+			AssetPaths.Num() - 1,
+			DependencyBytes);
+	}
+
 	// 设置超时定时器
-	if (WorldContext.IsValid())
+	if (FTimerManager* const TimerManager = GetTimerManager())
 	{
-		FTimerHandle TimeoutHandle;
-		WorldContext->GetTimerManager().SetTimer(
-			TimeoutHandle,
-			[this, RequestId = Request.RequestId]()
+		TimerManager->SetTimer(
+			InFlightLoad.TimeoutHandle,
+			[this, WidgetClass]()
 			{
-				HandleLoadTimeout(RequestId);
+				HandleLoadTimeout(WidgetClass);
 			},
 			LoadTimeoutSeconds,
 			false
 		);
-		TimeoutHandles.Add(Request.RequestId, TimeoutHandle);
 	}
 
 	// 开始异步加载
 	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(
-		Request.WidgetClass.ToSoftObjectPath(),
-		[this, Request]()
+		MoveTemp(AssetPaths),
+		[this, WidgetClass]()
 		{
-			OnWidgetClassLoaded(Request);
+			OnWidgetClassLoaded(WidgetClass);
 		}
 	);
 
 	if (Handle.IsValid())
 	{
-		ActiveHandles.Add(Request.RequestId, Handle);
+		// 已加载的资源可能会同步回调，此时加载已经结束
+		if (FInFlightWidgetLoad* const StartedLoad = InFlightLoads.Find(WidgetClass))
+		{
+			StartedLoad->Handle = Handle;
+		}
 	}
 	else
 	{
-		UINAV_LOG("StartLoadingWidget: Failed to create streamable handle for %s", *Request.WidgetClass.GetAssetName());
-		
+		UINAV_LOG("StartLoadingWidget: Failed to create streamable handle for %s", *WidgetClass.GetAssetName());
+
 		// 立即回调失败
-		if (Request.OnLoadFailed.IsBound())
-		{
-			Request.OnLoadFailed.ExecuteIfBound(TEXT("Failed to create streamable handle"));
-		}
-		
-		// 从活跃列表中移除
-		for (int32 i = 0; i < ActiveRequests.Num(); ++i)
+		FInFlightWidgetLoad FailedLoad;
+		RemoveInFlightLoad(WidgetClass, FailedLoad, false);
+
+		FAsyncWidgetLoadRequest FailedRequest;
+		if (RemoveActiveRequest(RequestId, FailedRequest))
 		{
-			if (ActiveRequests[i].RequestId == Request.RequestId)
-			{
-				ActiveRequests.RemoveAt(i);
-				break;
-			}
+			FailRequest(FailedRequest, TEXT("Failed to create streamable handle"));
 		}
-		
-		FailedRequestCount++;
-		ProcessNextRequest();
 	}
 }
 
-void UUINavAsyncWidgetManager::OnWidgetClassLoaded(const FAsyncWidgetLoadRequest& Request)
+void UUINavAsyncWidgetManager::OnWidgetClassLoaded(const TSoftClassPtr<UUINavWidget> WidgetClass)
 {
-	UINAV_LOG("OnWidgetClassLoaded: Load completed for %s (ID: %s)", 
-		*Request.WidgetClass.GetAssetName(), 
-		*Request.RequestId.ToString());
-
-	// 清理句柄和定时器
-	ActiveHandles.Remove(Request.RequestId);
-	
-	if (FTimerHandle* TimeoutHandle = TimeoutHandles.Find(Request.RequestId))
-	{
-		if (WorldContext.IsValid())
-		{
-			WorldContext->GetTimerManager().ClearTimer(*TimeoutHandle);
-		}
-		TimeoutHandles.Remove(Request.RequestId);
-	}
-
-	// 检查是否已被取消
-	if (Request.bCancelled || CancelledRequestIds.Contains(Request.RequestId))
+	// 所有订阅者都已取消或加载已超时
+	FInFlightWidgetLoad InFlightLoad;
+	if (!RemoveInFlightLoad(WidgetClass, InFlightLoad, false))
 	{
-		UINAV_LOG("OnWidgetClassLoaded: Request %s was cancelled", *Request.RequestId.ToString());
-		
-		// 从活跃列表中移除
-		for (int32 i = 0; i < ActiveRequests.Num(); ++i)
-		{
-			if (ActiveRequests[i].RequestId == Request.RequestId)
-			{
-				ActiveRequests.RemoveAt(i);
-				break;
-			}
-		}
-		
-		ProcessNextRequest();
+		UINAV_LOG("OnWidgetClassLoaded: Load of %s was cancelled", *WidgetClass.GetAssetName());
 		return;
 	}
 
+	UINAV_LOG("OnWidgetClassLoaded: Load completed for %s (%d requests)",
+		*WidgetClass.GetAssetName(),
+		InFlightLoad.RequestIds.Num());
+
 	// 加载Widget类
-	UClass* LoadedClass = Request.WidgetClass.Get();
+	UClass* LoadedClass = WidgetClass.Get();
 	if (!LoadedClass)
 	{
-		UINAV_LOG("OnWidgetClassLoaded: Failed to get loaded class for %s", *Request.WidgetClass.GetAssetName());
-		
-		if (Request.OnLoadFailed.IsBound())
-		{
-			Request.OnLoadFailed.ExecuteIfBound(TEXT("Failed to load widget class"));
-		}
-		
-		FailedRequestCount++;
+		UINAV_LOG("OnWidgetClassLoaded: Failed to get loaded class for %s", *WidgetClass.GetAssetName());
 	}
-	else
+	else if (!IsWidgetClassCached(WidgetClass))
+	{
+		// 将加载的类添加到缓存（如果还没有缓存的话），句柄随缓存保留，依赖资源不会被回收
+		AddToWidgetClassCache(WidgetClass, LoadedClass, InFlightLoad.Handle);
+	}
+
+	// 将结果分发给共享这次加载的所有请求
+	for (const FGuid& RequestId : InFlightLoad.RequestIds)
 	{
-		// 将加载的类添加到缓存（如果还没有缓存的话）
-		if (!IsWidgetClassCached(Request.WidgetClass))
+		FAsyncWidgetLoadRequest Request;
+		if (!RemoveActiveRequest(RequestId, Request))
 		{
-			AddToWidgetClassCache(Request.WidgetClass, LoadedClass);
+			continue;
 		}
 
-		// 创建并设置Widget
-		UUINavWidget* CreatedWidget = CreateAndSetupWidget(LoadedClass, Request);
-		
-		if (CreatedWidget)
+		FRequestLoadSize& LoadSize = FinishedLoadSizes.Add(RequestId);
+		LoadSize.NumAssets = InFlightLoad.NumAssets;
+		LoadSize.NumBytes = InFlightLoad.NumBytes;
+
+		if (LoadedClass)
 		{
-			UINAV_LOG("OnWidgetClassLoaded: Widget created successfully for %s", *Request.WidgetClass.GetAssetName());
-			
-			if (Request.OnLoadCompleted.IsBound())
-			{
-				Request.OnLoadCompleted.ExecuteIfBound(CreatedWidget);
-			}
-			
-			CompletedRequestCount++;
+			CompleteRequest(Request, LoadedClass);
 		}
 		else
 		{
-			UINAV_LOG("OnWidgetClassLoaded: Failed to create widget for %s", *Request.WidgetClass.GetAssetName());
-			
-			if (Request.OnLoadFailed.IsBound())
-			{
-				Request.OnLoadFailed.ExecuteIfBound(TEXT("Failed to create widget instance"));
-			}
-			
-			FailedRequestCount++;
+			FailRequest(Request, TEXT("Failed to load widget class"));
 		}
 	}
 
-	// 从活跃列表中移除
-	for (int32 i = 0; i < ActiveRequests.Num(); ++i)
+	// 处理下一个请求
+	ProcessPendingRequests();
+}
+
+void UUINavAsyncWidgetManager::HandleLoadTimeout(const TSoftClassPtr<UUINavWidget> WidgetClass)
+{
+	UINAV_LOG("HandleLoadTimeout: Load of %s timed out", *WidgetClass.GetAssetName());
+
+	FInFlightWidgetLoad InFlightLoad;
+	if (!RemoveInFlightLoad(WidgetClass, InFlightLoad, true))
+	{
+		return;
+	}
+
+	// 标记为已取消并回调失败
+	for (const FGuid& RequestId : InFlightLoad.RequestIds)
 	{
-		if (ActiveRequests[i].RequestId == Request.RequestId)
+		FAsyncWidgetLoadRequest Request;
+		if (!RemoveActiveRequest(RequestId, Request))
 		{
-			ActiveRequests.RemoveAt(i);
-			break;
+			continue;
 		}
+
+		CancelledRequestIds.Add(RequestId);
+		FailRequest(Request, TEXT("Load timeout"));
 	}
 
 	// 处理下一个请求
-	ProcessNextRequest();
+	ProcessPendingRequests();
+}
+
+void UUINavAsyncWidgetManager::CompleteRequest(const FAsyncWidgetLoadRequest& Request, TSubclassOf<UUINavWidget> LoadedClass)
+{
+	// 预加载只需要类引用
+	if (Request.bPreloadOnly)
+	{
+		UINAV_LOG("CompleteRequest: Successfully preloaded %s", *Request.WidgetClass.GetAssetName());
+		CompletedRequestCount++;
+		return;
+	}
+
+	// 创建并设置Widget
+	UUINavWidget* CreatedWidget = CreateAndSetupWidget(LoadedClass, Request);
+	if (!CreatedWidget)
+	{
+		UINAV_LOG("CompleteRequest: Failed to create widget for %s", *Request.WidgetClass.GetAssetName());
+		FailRequest(Request, TEXT("Failed to create widget instance"));
+		return;
+	}
+
+	UINAV_LOG("CompleteRequest: Widget created successfully for %s", *Request.WidgetClass.GetAssetName());
+
+	CompletedRequestCount++;
+	Request.OnLoadCompleted.ExecuteIfBound(CreatedWidget);
+}
+
+void UUINavAsyncWidgetManager::FailRequest(const FAsyncWidgetLoadRequest& Request, const FString& ErrorMessage)
+{
+	FailedRequestCount++;
+	Request.OnLoadFailed.ExecuteIfBound(ErrorMessage);
 }
 
-void UUINavAsyncWidgetManager::HandleLoadTimeout(const FGuid& RequestId)
+int64 UUINavAsyncWidgetManager::GatherWidgetDependencies(const TSoftClassPtr<UUINavWidget>& WidgetClass, TArray<FSoftObjectPath>& OutAssetPaths) const
 {
-	UINAV_LOG("HandleLoadTimeout: Request %s timed out", *RequestId.ToString());
+	IAssetRegistry* const AssetRegistry = IAssetRegistry::Get();
+	if (AssetRegistry == nullptr)
+	{
+		return 0;
+	}
+
+	const FName WidgetPackageName = WidgetClass.ToSoftObjectPath().GetLongPackageFName();
 
-	// 查找并取消请求
-	for (int32 i = 0; i < ActiveRequests.Num(); ++i)
+	int64 TotalBytes = 0;
+	TSet<FName> VisitedPackages = { WidgetPackageName };
+	TArray<FName> CurrentLevel = { WidgetPackageName };
+	TArray<FName> NextLevel;
+	TArray<FName> Dependencies;
+	TArray<FAssetData> PackageAssets;
+
+	// 按层级广度优先收集，直到达到最大层级或字节数上限
+	for (int32 Depth = 0; Depth < MaxDependencyDepth && CurrentLevel.Num() > 0; ++Depth)
 	{
-		if (ActiveRequests[i].RequestId == RequestId)
+		NextLevel.Reset();
+		for (const FName PackageName : CurrentLevel)
 		{
-			FAsyncWidgetLoadRequest& Request = ActiveRequests[i];
-			
-			// 取消Streamable句柄
-			if (TSharedPtr<FStreamableHandle>* HandlePtr = ActiveHandles.Find(RequestId))
+			Dependencies.Reset();
+			AssetRegistry->GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Game);
+
+			for (const FName Dependency : Dependencies)
 			{
-				if (HandlePtr->IsValid())
+				bool bAlreadyVisited = false;
+				VisitedPackages.Add(Dependency, &bAlreadyVisited);
+				if (bAlreadyVisited || FPackageName::IsScriptPackage(Dependency.ToString()))
 				{
-					(*HandlePtr)->CancelHandle();
+					continue;
 				}
-				ActiveHandles.Remove(RequestId);
-			}
 
-			// 回调失败
-			if (Request.OnLoadFailed.IsBound())
-			{
-				Request.OnLoadFailed.ExecuteIfBound(TEXT("Load timeout"));
-			}
+				// 已经加载的包及其依赖不需要再次加载
+				if (FindPackage(nullptr, *Dependency.ToString()) != nullptr)
+				{
+					continue;
+				}
 
-			// 标记为已取消并移除
-			Request.bCancelled = true;
-			CancelledRequestIds.Add(RequestId);
-			ActiveRequests.RemoveAt(i);
-			
-			FailedRequestCount++;
-			TimeoutHandles.Remove(RequestId);
+				const TOptional<FAssetPackageData> PackageData = AssetRegistry->GetAssetPackageDataCopy(Dependency);
+				const int64 PackageBytes = PackageData.IsSet() ? FMath::Max<int64>(PackageData->DiskSize, 0) : 0;
+				if (MaxDependencyBytes > 0 && TotalBytes + PackageBytes > MaxDependencyBytes)
+				{
+					continue;
+				}
 
-			// 处理下一个请求
-			ProcessNextRequest();
-			break;
+				PackageAssets.Reset();
+				AssetRegistry->GetAssetsByPackageName(Dependency, PackageAssets, true);
+				for (const FAssetData& Asset : PackageAssets)
+				{
+					OutAssetPaths.Add(Asset.GetSoftObjectPath());
+				}
+
+				TotalBytes += PackageBytes;
+				NextLevel.Add(Dependency);
+			}
 		}
+
+		Swap(CurrentLevel, NextLevel);
 	}
+
+	return TotalBytes;
 }
 
-void UUINavAsyncWidgetManager::CleanupCompletedRequests()
+bool UUINavAsyncWidgetManager::RemoveActiveRequest(const FGuid& RequestId, FAsyncWidgetLoadRequest& OutRequest)
 {
-	// 清理已取消的请求ID（保留最近的一些用于查询）
-	const int32 MaxCancelledIds = 100;
-	if (CancelledRequestIds.Num() > MaxCancelledIds)
+	if (!ActiveRequests.RemoveAndCopyValue(RequestId, OutRequest))
+	{
+		return false;
+	}
+
+	RemoveLoadingClass(OutRequest.WidgetClass);
+	return true;
+}
+
+bool UUINavAsyncWidgetManager::RemoveInFlightLoad(const TSoftClassPtr<UUINavWidget>& WidgetClass, FInFlightWidgetLoad& OutLoad, const bool bCancelHandle)
+{
+	if (!InFlightLoads.RemoveAndCopyValue(WidgetClass, OutLoad))
+	{
+		return false;
+	}
+
+	// 清理句柄和定时器
+	if (bCancelHandle && OutLoad.Handle.IsValid())
+	{
+		OutLoad.Handle->CancelHandle();
+	}
+
+	if (FTimerManager* const TimerManager = GetTimerManager())
+	{
+		TimerManager->ClearTimer(OutLoad.TimeoutHandle);
+	}
+
+	if (FPlayerRequestQueue* const Queue = PlayerQueues.Find(OutLoad.OwningPlayer))
+	{
+		Queue->NumInFlightLoads--;
+	}
+
+	return true;
+}
+
+bool UUINavAsyncWidgetManager::PopPendingRequest(FPlayerRequestQueue& Queue, FAsyncWidgetLoadRequest& OutRequest)
+{
+	if (Queue.Heap.Num() == 0)
+	{
+		return false;
+	}
+
+	// 出队后请求仍然计入正在加载的Widget类
+	const FGuid RequestId = Queue.Heap[0].RequestId;
+	RemovePendingHeapEntry(Queue.Heap, 0);
+	return PendingRequests.RemoveAndCopyValue(RequestId, OutRequest);
+}
+
+bool UUINavAsyncWidgetManager::RemovePendingRequest(const FGuid& RequestId, FAsyncWidgetLoadRequest& OutRequest)
+{
+	const int32* const HeapIndex = PendingHeapIndices.Find(RequestId);
+	if (HeapIndex == nullptr || !PendingRequests.RemoveAndCopyValue(RequestId, OutRequest))
+	{
+		return false;
+	}
+
+	RemovePendingHeapEntry(PlayerQueues.FindChecked(OutRequest.OwningPlayer).Heap, *HeapIndex);
+	RemoveLoadingClass(OutRequest.WidgetClass);
+	return true;
+}
+
+void UUINavAsyncWidgetManager::RemovePendingHeapEntry(TArray<FPendingRequestEntry>& Heap, const int32 HeapIndex)
+{
+	PendingHeapIndices.Remove(Heap[HeapIndex].RequestId);
+
+	const int32 LastIndex = Heap.Num() - 1;
+	if (HeapIndex != LastIndex)
+	{
+		Heap.Swap(HeapIndex, LastIndex);
+		PendingHeapIndices[Heap[HeapIndex].RequestId] = HeapIndex;
+	}
+	Heap.Pop(EAllowShrinking::No);
+
+	if (HeapIndex < Heap.Num())
+	{
+		SiftPendingHeapDown(Heap, HeapIndex);
+		SiftPendingHeapUp(Heap, HeapIndex);
+	}
+}
+
+void UUINavAsyncWidgetManager::SiftPendingHeapUp(TArray<FPendingRequestEntry>& Heap, int32 HeapIndex)
+{
+	while (HeapIndex > 0)
+	{
+		const int32 ParentIndex = (HeapIndex - 1) / 2;
+		if (!IsHigherPriority(Heap[HeapIndex], Heap[ParentIndex]))
+		{
+			break;
+		}
+
+		SwapPendingHeapEntries(Heap, HeapIndex, ParentIndex);
+		HeapIndex = ParentIndex;
+	}
+}
+
+void UUINavAsyncWidgetManager::SiftPendingHeapDown(TArray<FPendingRequestEntry>& Heap, int32 HeapIndex)
+{
+	const int32 NumEntries = Heap.Num();
+	while (true)
+	{
+		const int32 LeftIndex = HeapIndex * 2 + 1;
+		if (LeftIndex >= NumEntries)
+		{
+			break;
+		}
+
+		const int32 RightIndex = LeftIndex + 1;
+		const int32 ChildIndex = RightIndex < NumEntries && IsHigherPriority(Heap[RightIndex], Heap[LeftIndex]) ? RightIndex : LeftIndex;
+		if (!IsHigherPriority(Heap[ChildIndex], Heap[HeapIndex]))
+		{
+			break;
+		}
+
+		SwapPendingHeapEntries(Heap, HeapIndex, ChildIndex);
+		HeapIndex = ChildIndex;
+	}
+}
+
+void UUINavAsyncWidgetManager::SwapPendingHeapEntries(TArray<FPendingRequestEntry>& Heap, const int32 IndexA, const int32 IndexB)
+{
+	Heap.Swap(IndexA, IndexB);
+	PendingHeapIndices[Heap[IndexA].RequestId] = IndexA;
+	PendingHeapIndices[Heap[IndexB].RequestId] = IndexB;
+}
+
+bool UUINavAsyncWidgetManager::IsHigherPriority(const FPendingRequestEntry& A, const FPendingRequestEntry& B)
+{
+	// 高优先级排在前面，如果优先级相同则早请求的排前面
+	if (A.Priority != B.Priority)
+	{
+		return A.Priority > B.Priority;
+	}
+	return A.SequenceNumber < B.SequenceNumber;
+}
+
+void UUINavAsyncWidgetManager::AddLoadingClass(const TSoftClassPtr<UUINavWidget>& WidgetClass)
+{
+	++LoadingClassCounts.FindOrAdd(WidgetClass);
+}
+
+void UUINavAsyncWidgetManager::RemoveLoadingClass(const TSoftClassPtr<UUINavWidget>& WidgetClass)
+{
+	int32* const LoadingCount = LoadingClassCounts.Find(WidgetClass);
+	if (LoadingCount != nullptr && --(*LoadingCount) <= 0)
+	{
+		LoadingClassCounts.Remove(WidgetClass);
+	}
+}
+
+namespace UINavAsyncQueueBenchmark
+{
+	// 索引队列之前的实现：数组 + 每次入队排序 + 线性查找，用作基准对比
+	struct FLinearRequestQueue
+	{
+		TArray<FAsyncWidgetLoadRequest> PendingRequests;
+		TSet<FGuid> CancelledRequestIds;
+
+		void Enqueue(const FAsyncWidgetLoadRequest& Request)
+		{
+			PendingRequests.Add(Request);
+			PendingRequests.Sort();
+		}
+
+		bool GetRequestStatus(const FGuid& RequestId, bool& bIsPending, bool& bIsCancelled) const
+		{
+			bIsPending = false;
+			bIsCancelled = CancelledRequestIds.Contains(RequestId);
+			if (bIsCancelled)
+			{
+				return true;
+			}
+
+			for (const FAsyncWidgetLoadRequest& Request : PendingRequests)
+			{
+				if (Request.RequestId == RequestId)
+				{
+					bIsPending = true;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool IsWidgetLoading(const TSoftClassPtr<UUINavWidget>& WidgetClass) const
+		{
+			for (const FAsyncWidgetLoadRequest& Request : PendingRequests)
+			{
+				if (Request.WidgetClass == WidgetClass && !Request.bCancelled)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool Cancel(const FGuid& RequestId)
+		{
+			for (int32 i = 0; i < PendingRequests.Num(); ++i)
+			{
+				if (PendingRequests[i].RequestId == RequestId)
+				{
+					CancelledRequestIds.Add(RequestId);
+					PendingRequests.RemoveAt(i);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool Pop(FAsyncWidgetLoadRequest& OutRequest)
+		{
+			while (PendingRequests.Num() > 0)
+			{
+				OutRequest = PendingRequests[0];
+				PendingRequests.RemoveAt(0);
+				if (!OutRequest.bCancelled && !CancelledRequestIds.Contains(OutRequest.RequestId))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
+	struct FTimings
+	{
+		double Enqueue = 0.0;
+		double Query = 0.0;
+		double Cancel = 0.0;
+		double Dequeue = 0.0;
+		int32 NumStatusHits = 0;
+		int32 NumCancelled = 0;
+		int32 NumDequeued = 0;
+	};
+
+	static TSoftClassPtr<UUINavWidget> GetWidgetClass(const int32 Index)
+	{
+		const FString AssetName = FString::Printf(TEXT("W_QueueBenchmark_%d"), Index);
+		return TSoftClassPtr<UUINavWidget>(FSoftObjectPath(FString::Printf(TEXT("/Game/Benchmark/%s.%s_C"), *AssetName, *AssetName)));
+	}
+
+	static void LogTimings(const TCHAR* Label, const FTimings& Timings)
+	{
+		UE_LOG(LogUINavigation, Display, TEXT("  %s (%d status hits):"), Label, Timings.NumStatusHits);
+		UE_LOG(LogUINavigation, Display, TEXT("    Enqueue: %.3f ms"), Timings.Enqueue * 1000.0);
+		UE_LOG(LogUINavigation, Display, TEXT("    Status queries: %.3f ms"), Timings.Query * 1000.0);
+		UE_LOG(LogUINavigation, Display, TEXT("    Cancel %d: %.3f ms"), Timings.NumCancelled, Timings.Cancel * 1000.0);
+		UE_LOG(LogUINavigation, Display, TEXT("    Dequeue %d: %.3f ms"), Timings.NumDequeued, Timings.Dequeue * 1000.0);
+	}
+
+	static double GetSpeedup(const double Baseline, const double Indexed)
+	{
+		return Indexed > 0.0 ? Baseline / Indexed : 0.0;
+	}
+}
+
+void UUINavAsyncWidgetManager::RunQueueBenchmark(UGameInstance* GameInstance, const int32 NumRequests)
+{
+	using namespace UINavAsyncQueueBenchmark;
+
+	if (NumRequests <= 0)
+	{
+		return;
+	}
+
+	// 子系统只能以GameInstance为Outer创建
+	if (!IsValid(GameInstance))
+	{
+		UE_LOG(LogUINavigation, Warning, TEXT("UINav async queue benchmark requires a game instance (run it in PIE or in a game)"));
+		return;
+	}
+
+	// 模拟关卡开始时大量预取的请求，分布在有限数量的Widget类上，两种实现使用同一组请求
+	constexpr int32 NumWidgetClasses = 64;
+	TArray<TSoftClassPtr<UUINavWidget>> WidgetClasses;
+	for (int32 i = 0; i < NumWidgetClasses; ++i)
+	{
+		WidgetClasses.Add(GetWidgetClass(i));
+	}
+
+	TArray<FAsyncWidgetLoadRequest> Requests;
+	Requests.Reserve(NumRequests);
+	for (int32 i = 0; i < NumRequests; ++i)
+	{
+		FAsyncWidgetLoadRequest& Request = Requests.AddDefaulted_GetRef();
+		Request.WidgetClass = WidgetClasses[i % NumWidgetClasses];
+		Request.Priority = i % 8;
+		Request.SequenceNumber = i;
+	}
+
+	// 基准：之前的线性队列
+	FTimings Baseline;
+	{
+		FLinearRequestQueue Queue;
+
+		double StartTime = FPlatformTime::Seconds();
+		for (const FAsyncWidgetLoadRequest& Request : Requests)
+		{
+			Queue.Enqueue(Request);
+		}
+		Baseline.Enqueue = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (const FAsyncWidgetLoadRequest& Request : Requests)
+		{
+			bool bIsPending, bIsCancelled;
+			Baseline.NumStatusHits += Queue.GetRequestStatus(Request.RequestId, bIsPending, bIsCancelled) ? 1 : 0;
+		}
+		for (const TSoftClassPtr<UUINavWidget>& WidgetClass : WidgetClasses)
+		{
+			Baseline.NumStatusHits += Queue.IsWidgetLoading(WidgetClass) ? 1 : 0;
+		}
+		Baseline.Query = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Requests.Num(); i += 2)
+		{
+			Baseline.NumCancelled += Queue.Cancel(Requests[i].RequestId) ? 1 : 0;
+		}
+		Baseline.Cancel = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		FAsyncWidgetLoadRequest Request;
+		while (Queue.Pop(Request))
+		{
+			++Baseline.NumDequeued;
+		}
+		Baseline.Dequeue = FPlatformTime::Seconds() - StartTime;
+	}
+
+	// 索引队列：使用独立的实例（不注册为子系统），只操作队列，不会发起真正的加载，也不会影响正在使用的队列
+	FTimings Indexed;
+	{
+		UUINavAsyncWidgetManager* const Manager = NewObject<UUINavAsyncWidgetManager>(GameInstance);
+
+		double StartTime = FPlatformTime::Seconds();
+		for (const FAsyncWidgetLoadRequest& Request : Requests)
+		{
+			Manager->EnqueueRequest(CopyTemp(Request));
+		}
+		Indexed.Enqueue = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (const FAsyncWidgetLoadRequest& Request : Requests)
+		{
+			bool bIsActive, bIsPending, bIsCancelled;
+			Indexed.NumStatusHits += Manager->GetRequestStatus(Request.RequestId, bIsActive, bIsPending, bIsCancelled) ? 1 : 0;
+		}
+		for (const TSoftClassPtr<UUINavWidget>& WidgetClass : WidgetClasses)
+		{
+			Indexed.NumStatusHits += Manager->IsWidgetLoading(WidgetClass) ? 1 : 0;
+		}
+		Indexed.Query = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Requests.Num(); i += 2)
+		{
+			Indexed.NumCancelled += Manager->CancelLoadRequest(Requests[i].RequestId) ? 1 : 0;
+		}
+		Indexed.Cancel = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		FAsyncWidgetLoadRequest Request;
+		FPlayerRequestQueue* Queue = nullptr;
+		while ((Queue = Manager->SelectNextPlayerQueue(true)) != nullptr && Manager->PopPendingRequest(*Queue, Request))
+		{
+			Manager->RemoveLoadingClass(Request.WidgetClass);
+			++Indexed.NumDequeued;
+		}
+		Indexed.Dequeue = FPlatformTime::Seconds() - StartTime;
+
+		Manager->MarkAsGarbage();
+	}
+
+	UE_LOG(LogUINavigation, Display, TEXT("UINav async queue benchmark (%d requests):"), NumRequests);
+	LogTimings(TEXT("Linear queue (baseline)"), Baseline);
+	LogTimings(TEXT("Indexed queue"), Indexed);
+	UE_LOG(LogUINavigation, Display, TEXT("  Speedup: enqueue %.1fx, status queries %.1fx, cancel %.1fx, dequeue %.1fx"),
+		GetSpeedup(Baseline.Enqueue, Indexed.Enqueue),
+		GetSpeedup(Baseline.Query, Indexed.Query),
+		GetSpeedup(Baseline.Cancel, Indexed.Cancel),
+		GetSpeedup(Baseline.Dequeue, Indexed.Dequeue));
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand UINavAsyncQueueBenchmarkCommand(
+	TEXT("UINav.AsyncQueueBenchmark"),
+	TEXT("Measures enqueue, status queries, cancellation and dequeue of the async widget load queue against the previous linear queue. The linear queue is quadratic, so large counts take a while. Usage: UINav.AsyncQueueBenchmark [NumRequests=10000]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumRequests = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10000;
+		UUINavAsyncWidgetManager::RunQueueBenchmark(IsValid(World) ? World->GetGameInstance() : nullptr, NumRequests);
+	})
+);
+#endif
+
+void UUINavAsyncWidgetManager::CleanupCompletedRequests()
+{
+	// 清理已取消的请求ID（保留最近的一些用于查询）
+	const int32 MaxCancelledIds = 100;
+	if (CancelledRequestIds.Num() > MaxCancelledIds)
 	{
 		// 转换为数组以便排序和移除旧的
 		TArray<FGuid> CancelledArray = CancelledRequestIds.Array();
@@ -606,6 +1155,46 @@ void UUINavAsyncWidgetManager::CleanupCompletedRequests()
 
 		UINAV_LOG("CleanupCompletedRequests: Cleaned up %d old cancelled request IDs", ToRemove);
 	}
+
+	// 移除空闲的玩家队列，并取消已离开的玩家的请求
+	for (auto It = PlayerQueues.CreateIterator(); It; ++It)
+	{
+		if (It.Value().Heap.Num() == 0 && It.Value().NumInFlightLoads <= 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TArray<FGuid> OrphanedRequestIds;
+	for (const TPair<FGuid, FAsyncWidgetLoadRequest>& ActiveRequest : ActiveRequests)
+	{
+		if (ActiveRequest.Value.OwningPlayer.IsStale())
+		{
+			OrphanedRequestIds.Add(ActiveRequest.Key);
+		}
+	}
+	for (const TPair<FGuid, FAsyncWidgetLoadRequest>& PendingRequest : PendingRequests)
+	{
+		if (PendingRequest.Value.OwningPlayer.IsStale())
+		{
+			OrphanedRequestIds.Add(PendingRequest.Key);
+		}
+	}
+	for (const FGuid& RequestId : OrphanedRequestIds)
+	{
+		CancelLoadRequest(RequestId);
+	}
+
+	// 清理已结束请求的加载大小（保留最近的一些用于查询）
+	const int32 MaxFinishedLoadSizes = 100;
+	if (FinishedLoadSizes.Num() > MaxFinishedLoadSizes)
+	{
+		int32 ToRemove = FinishedLoadSizes.Num() - MaxFinishedLoadSizes / 2;
+		for (auto It = FinishedLoadSizes.CreateIterator(); It && ToRemove > 0; ++It, --ToRemove)
+		{
+			It.RemoveCurrent();
+		}
+	}
 }
 
 UUINavWidget* UUINavAsyncWidgetManager::CreateAndSetupWidget(TSubclassOf<UUINavWidget> WidgetClass, const FAsyncWidgetLoadRequest& Request)
@@ -615,12 +1204,12 @@ UUINavWidget* UUINavAsyncWidgetManager::CreateAndSetupWidget(TSubclassOf<UUINavW
 		return nullptr;
 	}
 
-	// 获取UINavPC组件来创建Widget
+	// 获取发起请求的玩家的UINavPC组件来创建Widget
 	UUINavPCComponent* UINavPC = nullptr;
 	
-	if (WorldContext.IsValid())
+	if (const ULocalPlayer* const LocalPlayer = Request.OwningPlayer.Get())
 	{
-		if (APlayerController* PC = WorldContext->GetFirstPlayerController())
+		if (APlayerController* PC = LocalPlayer->GetPlayerController(GetGameInstance()->GetWorld()))
 		{
 			UINavPC = PC->FindComponentByClass<UUINavPCComponent>();
 		}
@@ -640,22 +1229,25 @@ UUINavWidget* UUINavAsyncWidgetManager::CreateAndSetupWidget(TSubclassOf<UUINavW
 
 void UUINavAsyncWidgetManager::PrintDebugInfo() const
 {
-	UE_LOG(LogTemp, Warning, TEXT("=== UINavAsyncWidgetManager Debug Info ==="));
-	UE_LOG(LogTemp, Warning, TEXT("Active Requests: %d"), ActiveRequests.Num());
-	UE_LOG(LogTemp, Warning, TEXT("Pending Requests: %d"), PendingRequests.Num());
-	UE_LOG(LogTemp, Warning, TEXT("Max Concurrent Loads: %d"), MaxConcurrentLoads);
-	UE_LOG(LogTemp, Warning, TEXT("Load Timeout: %.2f seconds"), LoadTimeoutSeconds);
-	UE_LOG(LogTemp, Warning, TEXT("Cancelled Request IDs: %d"), CancelledRequestIds.Num());
-	UE_LOG(LogTemp, Warning, TEXT("Statistics:"));
-	UE_LOG(LogTemp, Warning, TEXT("  Total: %d, Completed: %d, Failed: %d, Cancelled: %d"), 
-		TotalRequestCount, CompletedRequestCount, FailedRequestCount, CancelledRequestCount);
+	UE_LOG(LogUINavigation, Warning, TEXT("=== UINavAsyncWidgetManager Debug Info ==="));
+	UE_LOG(LogUINavigation, Warning, TEXT("Active Requests: %d"), ActiveRequests.Num());
+	UE_LOG(LogUINavigation, Warning, TEXT("Pending Requests: %d"), PendingRequests.Num());
+	UE_LOG(LogUINavigation, Warning, TEXT("In-Flight Loads: %d"), InFlightLoads.Num());
+	UE_LOG(LogUINavigation, Warning, TEXT("Max Concurrent Loads: %d"), MaxConcurrentLoads);
+	UE_LOG(LogUINavigation, Warning, TEXT("Load Timeout: %.2f seconds"), LoadTimeoutSeconds);
+	UE_LOG(LogUINavigation, Warning, TEXT("Cancelled Request IDs: %d"), CancelledRequestIds.Num());
+	UE_LOG(LogUINavigation, Warning, TEXT("Cached Widget Classes: %d (%d pinned), %lld bytes"), WidgetClassCache.Num(), PinnedWidgetClasses.Num(), CachedResourceBytes);
+	UE_LOG(LogUINavigation, Warning, TEXT("Statistics:"));
+	UE_LOG(LogUINavigation, Warning, TEXT("  Total: %d, Completed: %d, Failed: %d, Cancelled: %d, Coalesced: %d"), 
+		TotalRequestCount, CompletedRequestCount, FailedRequestCount, CancelledRequestCount, CoalescedRequestCount);
 	
 	if (ActiveRequests.Num() > 0)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Active Requests Details:"));
-		for (const FAsyncWidgetLoadRequest& Request : ActiveRequests)
+		UE_LOG(LogUINavigation, Warning, TEXT("Active Requests Details:"));
+		for (const TPair<FGuid, FAsyncWidgetLoadRequest>& ActiveRequest : ActiveRequests)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("  ID: %s, Class: %s, Priority: %d"), 
+			const FAsyncWidgetLoadRequest& Request = ActiveRequest.Value;
+			UE_LOG(LogUINavigation, Warning, TEXT("  ID: %s, Class: %s, Priority: %d"), 
 				*Request.RequestId.ToString(), 
 				*Request.WidgetClass.GetAssetName(), 
 				Request.Priority);
@@ -674,29 +1266,50 @@ void UUINavAsyncWidgetManager::GetLoadStatistics(int32& TotalRequests, int32& Co
 void UUINavAsyncWidgetManager::ClearCache()
 {
 	UINAV_LOG("ClearCache: Clearing widget class cache (%d entries)", WidgetClassCache.Num());
-	
-	// 清空Widget类缓存
-	WidgetClassCache.Empty();
-	
-	// 取消所有缓存句柄
-	for (const auto& CacheHandle : CacheHandles)
+
+	// 清空未固定的Widget类缓存并释放其句柄
+	TArray<TSoftClassPtr<UUINavWidget>> CachedClasses;
+	WidgetClassCache.GetKeys(CachedClasses);
+	for (const TSoftClassPtr<UUINavWidget>& CachedClass : CachedClasses)
 	{
-		if (CacheHandle.IsValid() && CacheHandle->IsActive())
+		if (!PinnedWidgetClasses.Contains(CachedClass))
 		{
-			CacheHandle->CancelHandle();
+			RemoveFromWidgetClassCache(CachedClass);
 		}
 	}
-	CacheHandles.Empty();
-	
-	// 清理StreamableManager的缓存
-	StreamableManager.RequestAsyncLoad(TArray<FSoftObjectPath>(), FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
-	
-	UINAV_LOG("ClearCache: Cache cleared successfully");
+
+	UINAV_LOG("ClearCache: Cache cleared successfully (%d pinned entries kept)", WidgetClassCache.Num());
 }
 
-FGuid UUINavAsyncWidgetManager::PreloadWidgetClass(TSoftClassPtr<UUINavWidget> WidgetClass, int32 Priority)
+void UUINavAsyncWidgetManager::SetCacheLimits(int32 MaxEntries, int64 MaxBytes)
 {
-	if (!WidgetClass.IsValid())
+	MaxCachedWidgetClasses = FMath::Max(0, MaxEntries);
+	MaxCacheBytes = FMath::Max<int64>(0, MaxBytes);
+	UINAV_LOG("SetCacheLimits: %d entries, %lld bytes", MaxCachedWidgetClasses, MaxCacheBytes);
+
+	TrimWidgetClassCache();
+}
+
+void UUINavAsyncWidgetManager::SetWidgetClassPinned(TSoftClassPtr<UUINavWidget> WidgetClass, bool bPinned)
+{
+	if (WidgetClass.IsNull())
+	{
+		return;
+	}
+
+	if (bPinned)
+	{
+		PinnedWidgetClasses.Add(WidgetClass);
+	}
+	else if (PinnedWidgetClasses.Remove(WidgetClass) > 0)
+	{
+		TrimWidgetClassCache();
+	}
+}
+
+FGuid UUINavAsyncWidgetManager::PreloadWidgetClass(TSoftClassPtr<UUINavWidget> WidgetClass, int32 Priority, bool bLoadDependencies)
+{
+	if (WidgetClass.IsNull())
 	{
 		UINAV_LOG("PreloadWidgetClass: Invalid widget class");
 		return FGuid();
@@ -709,53 +1322,27 @@ FGuid UUINavAsyncWidgetManager::PreloadWidgetClass(TSoftClassPtr<UUINavWidget> W
 		return FGuid();
 	}
 
-	// 创建预加载请求
+	// 创建预加载请求，加载完成后只缓存类引用，不创建Widget实例
 	FAsyncWidgetLoadRequest PreloadRequest;
 	PreloadRequest.WidgetClass = WidgetClass;
 	PreloadRequest.Priority = Priority;
-	PreloadRequest.bRemoveParent = false;
-	PreloadRequest.bDestroyParent = false;
-	PreloadRequest.ZOrder = 0;
-
-	// 创建预加载完成回调
-	PreloadRequest.OnLoadCompleted.BindLambda([this, WidgetClass](UUINavWidget* Widget)
-	{
-		if (Widget)
-		{
-			// 将加载的类添加到缓存
-			AddToWidgetClassCache(WidgetClass, Widget->GetClass());
-			UINAV_LOG("PreloadWidgetClass: Successfully preloaded and cached %s", *WidgetClass.ToString());
-			
-			// 立即销毁Widget实例，我们只需要类引用
-			Widget->RemoveFromParent();
-		}
-	});
-
-	PreloadRequest.OnLoadFailed.BindLambda([WidgetClass](const FString& ErrorMessage)
-	{
-		UINAV_LOG("PreloadWidgetClass: Failed to preload %s - %s", *WidgetClass.ToString(), *ErrorMessage);
-	});
+	PreloadRequest.bLoadDependencies = bLoadDependencies;
+	PreloadRequest.bPreloadOnly = true;
 
 	UINAV_LOG("PreloadWidgetClass: Starting preload for %s with priority %d", *WidgetClass.ToString(), Priority);
 
 	// 添加到请求队列
 	++TotalRequestCount;
 
-	// 如果有空闲槽位，直接开始加载
-	if (ActiveRequests.Num() < MaxConcurrentLoads)
-	{
-		ActiveRequests.Add(PreloadRequest);
-		StartLoadingWidget(PreloadRequest);
-	}
-	else
+	const FGuid RequestId = PreloadRequest.RequestId;
+	SubmitRequest(MoveTemp(PreloadRequest));
+
+	if (PendingRequests.Contains(RequestId))
 	{
-		// 添加到等待队列并按优先级排序
-		PendingRequests.Add(PreloadRequest);
-		PendingRequests.Sort();
 		UINAV_LOG("PreloadWidgetClass: Request queued (Queue size: %d)", PendingRequests.Num());
 	}
 
-	return PreloadRequest.RequestId;
+	return RequestId;
 }
 
 bool UUINavAsyncWidgetManager::IsWidgetClassCached(TSoftClassPtr<UUINavWidget> WidgetClass) const
@@ -768,50 +1355,105 @@ bool UUINavAsyncWidgetManager::IsWidgetClassCached(TSoftClassPtr<UUINavWidget> W
 	return WidgetClassCache.Contains(WidgetClass);
 }
 
-void UUINavAsyncWidgetManager::GetCacheStatistics(int32& CachedWidgetClasses, int32& TotalCacheSize) const
+void UUINavAsyncWidgetManager::GetCacheStatistics(int32& CachedWidgetClasses, int64& TotalCacheSize) const
 {
 	CachedWidgetClasses = WidgetClassCache.Num();
-	
-	// 估算缓存大小（简单估算，每个缓存条目大约占用的字节数）
-	TotalCacheSize = 0;
-	for (const auto& CacheEntry : WidgetClassCache)
-	{
-		// 软引用路径字符串大小 + 类指针大小
-		TotalCacheSize += CacheEntry.Key.ToString().Len() * sizeof(TCHAR) + sizeof(TSubclassOf<UUINavWidget>);
-	}
-	
-	// 添加缓存句柄的大小
-	TotalCacheSize += CacheHandles.Num() * sizeof(TSharedPtr<FStreamableHandle>);
+	TotalCacheSize = CachedResourceBytes;
 }
 
-void UUINavAsyncWidgetManager::AddToWidgetClassCache(TSoftClassPtr<UUINavWidget> SoftClass, TSubclassOf<UUINavWidget> LoadedClass)
+void UUINavAsyncWidgetManager::AddToWidgetClassCache(TSoftClassPtr<UUINavWidget> SoftClass, TSubclassOf<UUINavWidget> LoadedClass, const TSharedPtr<FStreamableHandle>& Handle)
 {
 	if (!SoftClass.IsValid() || !LoadedClass)
 	{
 		return;
 	}
 
-	WidgetClassCache.Add(SoftClass, LoadedClass);
-	UINAV_LOG("AddToWidgetClassCache: Added %s to cache", *SoftClass.ToString());
+	RemoveFromWidgetClassCache(SoftClass);
+
+	FUINavCachedWidgetClass& CacheEntry = WidgetClassCache.Add(SoftClass);
+	CacheEntry.WidgetClass = LoadedClass;
+	CacheEntry.Handle = Handle;
+	CacheEntry.ResourceBytes = GetLoadedResourceBytes(LoadedClass, Handle);
+	CacheEntry.LastAccess = ++CacheAccessCounter;
+	CachedResourceBytes += CacheEntry.ResourceBytes;
+
+	UINAV_LOG("AddToWidgetClassCache: Added %s to cache (%lld bytes)", *SoftClass.ToString(), CacheEntry.ResourceBytes);
+
+	TrimWidgetClassCache();
 }
 
-TSubclassOf<UUINavWidget> UUINavAsyncWidgetManager::GetFromWidgetClassCache(TSoftClassPtr<UUINavWidget> SoftClass) const
+TSubclassOf<UUINavWidget> UUINavAsyncWidgetManager::GetFromWidgetClassCache(TSoftClassPtr<UUINavWidget> SoftClass)
 {
-	if (const TSubclassOf<UUINavWidget>* FoundClass = WidgetClassCache.Find(SoftClass))
+	if (FUINavCachedWidgetClass* const CacheEntry = WidgetClassCache.Find(SoftClass))
 	{
-		return *FoundClass;
+		CacheEntry->LastAccess = ++CacheAccessCounter;
+		return CacheEntry->WidgetClass;
 	}
 	return nullptr;
 }
 
-void UUINavAsyncWidgetManager::CleanupCacheHandles()
+void UUINavAsyncWidgetManager::RemoveFromWidgetClassCache(const TSoftClassPtr<UUINavWidget>& SoftClass)
+{
+	FUINavCachedWidgetClass CacheEntry;
+	if (!WidgetClassCache.RemoveAndCopyValue(SoftClass, CacheEntry))
+	{
+		return;
+	}
+
+	if (CacheEntry.Handle.IsValid())
+	{
+		CacheEntry.Handle->ReleaseHandle();
+	}
+
+	CachedResourceBytes -= CacheEntry.ResourceBytes;
+}
+
+void UUINavAsyncWidgetManager::TrimWidgetClassCache()
 {
-	// 移除已经完成或无效的缓存句柄
-	for (int32 i = CacheHandles.Num() - 1; i >= 0; --i)
+	while ((MaxCachedWidgetClasses > 0 && WidgetClassCache.Num() > MaxCachedWidgetClasses) ||
+		(MaxCacheBytes > 0 && CachedResourceBytes > MaxCacheBytes))
+	{
+		// 找到最久未使用且未固定的Widget类
+		const TSoftClassPtr<UUINavWidget>* LeastRecentlyUsed = nullptr;
+		uint64 OldestAccess = MAX_uint64;
+		for (const TPair<TSoftClassPtr<UUINavWidget>, FUINavCachedWidgetClass>& CacheEntry : WidgetClassCache)
+		{
+			if (CacheEntry.Value.LastAccess < OldestAccess && !PinnedWidgetClasses.Contains(CacheEntry.Key))
+			{
+				OldestAccess = CacheEntry.Value.LastAccess;
+				LeastRecentlyUsed = &CacheEntry.Key;
+			}
+		}
+
+		// 剩下的都是固定的Widget类
+		if (LeastRecentlyUsed == nullptr)
+		{
+			break;
+		}
+
+		const TSoftClassPtr<UUINavWidget> EvictedClass = *LeastRecentlyUsed;
+		UINAV_LOG("TrimWidgetClassCache: Evicting %s", *EvictedClass.ToString());
+		RemoveFromWidgetClassCache(EvictedClass);
+	}
+}
+
+int64 UUINavAsyncWidgetManager::GetLoadedResourceBytes(UClass* LoadedClass, const TSharedPtr<FStreamableHandle>& Handle)
+{
+	TArray<UObject*> LoadedAssets;
+	if (Handle.IsValid())
+	{
+		Handle->GetLoadedAssets(LoadedAssets);
+	}
+	LoadedAssets.AddUnique(LoadedClass);
+	LoadedAssets.AddUnique(LoadedClass->GetDefaultObject());
+
+	int64 TotalBytes = 0;
+	for (UObject* const LoadedAsset : LoadedAssets)
 	{
-		if (!CacheHandles[i].IsValid() || !CacheHandles[i]->IsActive())
+		if (IsValid(LoadedAsset))
 		{
-			CacheHandles.RemoveAt(i);
+			TotalBytes += LoadedAsset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
 		}
 	}
+	return TotalBytes;
 }
@@ -8,6 +8,8 @@
 #include "UINavSettings.h"
 #include "UINavDefaultInputSettings.h"
 #include "UINavSavedInputSettings.h"
+#include "UINavLocalPlayerSubsystem.h"
+#include "UINavigationConfig.h"
 #include "UINavComponent.h"
 #include "UINavMacros.h"
 #include "Data/PromptData.h"
@@ -117,6 +119,14 @@ void UUINavBlueprintFunctionLibrary::ResetInputSettings(APlayerController* PC)
 			SavedInputSettings->SavedEnhancedInputMappings = DefaultUINavInputSettings->DefaultEnhancedInputMappings;
 			SavedInputSettings->SaveConfig();
 
+			UUINavLocalPlayerSubsystem* UINavLocalPlayerSubsystem = ULocalPlayer::GetSubsystem<UUINavLocalPlayerSubsystem>(PC->GetLocalPlayer());
+			if (IsValid(UINavLocalPlayerSubsystem))
+			{
+				UINavLocalPlayerSubsystem->ResetSavedInputContexts();
+			}
+
+			FUINavigationConfig::InvalidateCachedConfigs();
+
 			UUINavPCComponent* UINavPC = PC->FindComponentByClass<UUINavPCComponent>();
 			if (IsValid(UINavPC))
 			{
@@ -84,6 +84,8 @@ void UUINavComponent::NativeConstruct()
 		}
 	}
 
+	ParentWidget->AddNavComponent(this);
+
 	SetFocusable(IsFocusable() && GetIsEnabled());
 }
 
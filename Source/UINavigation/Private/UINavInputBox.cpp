@@ -130,6 +130,7 @@ bool UUINavInputBox::TrySetupNewKey(const FKey& NewKey, const int KeyIndex, UUIN
 	if (!NewKey.IsValid() || Keys.IsValidIndex(KeyIndex) || Keys.Contains(NewKey)) return false;
 
 	Keys.Add(NewKey);
+	Container->UpdateKeyOccupancy(this, Keys.Num() - 1, FKey(), NewKey);
 
 	if (UpdateKeyIconForKey(KeyIndex))
 	{
@@ -148,6 +149,10 @@ bool UUINavInputBox::TrySetupNewKey(const FKey& NewKey, const int KeyIndex, UUIN
 
 void UUINavInputBox::ResetKeyWidgets()
 {
+	for (int i = 0; i < Keys.Num(); ++i)
+	{
+		Container->UpdateKeyOccupancy(this, i, Keys[i], FKey());
+	}
 	Keys.Empty();
 	bUsingKeyImage = { false, false, false };
 	InputButtons.Empty();
@@ -216,8 +221,6 @@ int32 UUINavInputBox::FinishUpdateNewKey(const bool bIsHold /*= false*/, const i
 	int32 ModifiedActionMappingIndex = FinishUpdateNewEnhancedInputKey(AwaitingNewKey, AwaitingIndex, bIsHold, MappingIndexToIgnore, TriggerToUse);
 
 	Container->OnKeyRebinded(InputName, OldKey, Keys[AwaitingIndex]);
-	Container->UINavPC->RefreshNavigationKeys();
-	Container->UINavPC->UpdateInputIconsDelegate.Broadcast();
 	AwaitingIndex = -1;
 
 	return ModifiedActionMappingIndex;
@@ -277,6 +280,7 @@ int32 UUINavInputBox::FinishUpdateNewEnhancedInputKey(const FKey& PressedKey, co
 						{
 							ActionMapping.Key = NewKey;
 						}
+						Container->UpdateKeyOccupancy(this, Index, Keys[Index], NewKey);
 						Keys[Index] = NewKey;
 						InputButtons[Index]->SetText(GetKeyText(Index));
 
@@ -366,6 +370,7 @@ int32 UUINavInputBox::FinishUpdateNewEnhancedInputKey(const FKey& PressedKey, co
 			UnmapEnhancedAxisKey(NewAxisKey, OldAxisKey, NewKey, Index, bNegateX, bNegateY, bNegateZ);
 		}
 
+		Container->UpdateKeyOccupancy(this, Index, Keys[Index], NewKey);
 		Keys[Index] = NewKey;
 		InputButtons[Index]->SetText(GetKeyText(Index));
 
@@ -378,9 +383,8 @@ int32 UUINavInputBox::FinishUpdateNewEnhancedInputKey(const FKey& PressedKey, co
 		TryMapEnhancedAxisKey(NewKey, Index);
 	}
 
-	Container->UINavPC->RequestRebuildMappings();
-
-	ULocalPlayer::GetSubsystem<UUINavLocalPlayerSubsystem>(GetOwningLocalPlayer())->SaveInputContextState(InputContext);
+	// The control mappings, navigation keys and input icons are refreshed, and the context saved, once for all the rebinds made this frame
+	ULocalPlayer::GetSubsystem<UUINavLocalPlayerSubsystem>(GetOwningLocalPlayer())->NotifyInputContextChanged(InputContext);
 
 	UpdateKeyDisplay(Index);
 
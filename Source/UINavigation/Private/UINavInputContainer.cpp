@@ -8,10 +8,12 @@
 #include "UINavComponent.h"
 #include "UINavInputComponent.h"
 #include "UINavBlueprintFunctionLibrary.h"
+#include "UINavLocalPlayerSubsystem.h"
 #include "Blueprint/UserWidget.h"
 #include "Blueprint/WidgetTree.h"
 #include "Engine/DataTable.h"
 #include "GameFramework/PlayerController.h"
+#include "Engine/LocalPlayer.h"
 #include "Components/PanelWidget.h"
 #include "Components/TextBlock.h"
 #include "Components/RichTextBlock.h"
@@ -24,6 +26,8 @@
 #include "Data/PromptDataSwapKeys.h"
 #include "Data/PlatformConfigData.h"
 
+DECLARE_CYCLE_STAT(TEXT("UINavInputContainer CanRegisterKey"), STAT_UINavInputContainer_CanRegisterKey, STATGROUP_UINavigation);
+
 void UUINavInputContainer::NativeConstruct()
 {
 	ParentWidget = UUINavWidget::GetOuterObject<UUINavWidget>(this);
@@ -59,6 +63,13 @@ void UUINavInputContainer::NativeConstruct()
 
 	SetupInputBoxes();
 
+	UUINavLocalPlayerSubsystem* const UINavLocalPlayerSubsystem = ULocalPlayer::GetSubsystem<UUINavLocalPlayerSubsystem>(GetOwningLocalPlayer());
+	if (IsValid(UINavLocalPlayerSubsystem) && !UINavLocalPlayerSubsystem->AreSavedInputContextsApplied())
+	{
+		// The input boxes are created right away so they can be navigated, and their keys are read again once the saved mappings are applied
+		UINavLocalPlayerSubsystem->SavedInputContextsAppliedDelegate.AddUniqueDynamic(this, &UUINavInputContainer::OnSavedInputContextsApplied);
+	}
+
 	Super::NativeConstruct();
 }
 
@@ -69,6 +80,11 @@ void UUINavInputContainer::NativeDestruct()
 		UINavPC->InputTypeChangedDelegate.RemoveAll(this);
 	}
 
+	if (UUINavLocalPlayerSubsystem* const UINavLocalPlayerSubsystem = ULocalPlayer::GetSubsystem<UUINavLocalPlayerSubsystem>(GetOwningLocalPlayer()))
+	{
+		UINavLocalPlayerSubsystem->SavedInputContextsAppliedDelegate.RemoveAll(this);
+	}
+
 	Super::NativeDestruct();
 }
 
@@ -133,6 +149,16 @@ void UUINavInputContainer::ForceUpdateInputBoxes()
 	for (UUINavInputBox* InputBox : InputBoxes) InputBox->ResetKeyWidgets();
 }
 
+void UUINavInputContainer::OnSavedInputContextsApplied()
+{
+	if (UUINavLocalPlayerSubsystem* const UINavLocalPlayerSubsystem = ULocalPlayer::GetSubsystem<UUINavLocalPlayerSubsystem>(GetOwningLocalPlayer()))
+	{
+		UINavLocalPlayerSubsystem->SavedInputContextsAppliedDelegate.RemoveAll(this);
+	}
+
+	ForceUpdateInputBoxes();
+}
+
 UUINavInputBox* UUINavInputContainer::GetInputBoxAtIndex(const int Index) const
 {
 	if (Index == -1 && InputBoxes.Num() > 0)
@@ -153,6 +179,8 @@ void UUINavInputContainer::SetupInputBoxes()
 	if (InputBox_BP == nullptr) return;
 
 	InputBoxes.Reset();
+	KeyOccupancy.Reset();
+	AxisScaleInputBoxes.Reset();
 
 	NumberOfInputs = 0;
 	for (const TPair<UInputMappingContext*, FInputContainerEnhancedActionDataArray>& Context : EnhancedInputs)
@@ -169,6 +197,20 @@ void UUINavInputContainer::SetupInputBoxes()
 	CreateInputBoxes();
 }
 
+void UUINavInputContainer::BuildAxisScaleInputBoxes()
+{
+	AxisScaleInputBoxes.Reset();
+
+	for (int i = 0; i < InputBoxes.Num(); ++i)
+	{
+		const FInputContainerEnhancedActionData& ActionData = InputBoxes[i]->InputActionData;
+		if (ActionData.AxisScale != EAxisType::None)
+		{
+			AxisScaleInputBoxes.FindOrAdd(MakeTuple(static_cast<const UInputAction*>(ActionData.Action), ActionData.Axis, ActionData.AxisScale), i);
+		}
+	}
+}
+
 void UUINavInputContainer::CreateInputBoxes()
 {
 	if (InputBox_BP == nullptr || UINavPC == nullptr) return;
@@ -176,7 +218,7 @@ void UUINavInputContainer::CreateInputBoxes()
 	for (int i = 0; i < NumberOfInputs; ++i)
 	{
 		UUINavInputBox* NewInputBox = CreateWidget<UUINavInputBox>(this, InputBox_BP);
-		InputBoxes.Add(NewInputBox);
+		NewInputBox->ContainerIndex = InputBoxes.Add(NewInputBox);
 		NewInputBox->Container = this;
 		NewInputBox->KeysPerInput = KeysPerInput;
 
@@ -197,6 +239,8 @@ void UUINavInputContainer::CreateInputBoxes()
 		}
 	}
 
+	BuildAxisScaleInputBoxes();
+
 	for (int i = 0; i < NumberOfInputs; ++i)
 	{
 		UUINavInputBox* const InputBox = InputBoxes[i];
@@ -207,6 +251,8 @@ void UUINavInputContainer::CreateInputBoxes()
 
 ERevertRebindReason UUINavInputContainer::CanRegisterKey(UUINavInputBox * InputBox, const FKey NewKey, const bool bIsHold, const int Index, int& OutCollidingActionIndex, int& OutCollidingKeyIndex)
 {
+	UINAV_SCOPE_STAT(STAT_UINavInputContainer_CanRegisterKey);
+
 	if (!NewKey.IsValid()) return ERevertRebindReason::BlacklistedKey;
 	if (KeyWhitelist.Num() > 0 && !KeyWhitelist.Contains(NewKey)) return ERevertRebindReason::NonWhitelistedKey;
 	if (KeyBlacklist.Contains(NewKey)) return ERevertRebindReason::BlacklistedKey;
@@ -223,46 +269,51 @@ bool UUINavInputContainer::CanUseKey(UUINavInputBox* InputBox, const FKey Compar
 {
 	if (InputBox->EnhancedInputGroups.Num() == 0) InputBox->EnhancedInputGroups.Add(-1);
 
-	for (int i = 0; i < InputBoxes.Num(); ++i)
+	const TArray<FInputBoxKeySlot>* const KeySlots = KeyOccupancy.Find(CompareKey);
+	if (KeySlots == nullptr)
+	{
+		return true;
+	}
+
+	for (const FInputBoxKeySlot& KeySlot : *KeySlots)
 	{
-		if (InputBox == InputBoxes[i]) continue;
+		const int i = KeySlot.InputBoxIndex;
+		if (!InputBoxes.IsValidIndex(i) || InputBox == InputBoxes[i]) continue;
 
-		const int KeyIndex = InputBoxes[i]->ContainsKey(CompareKey);
-		if (KeyIndex != INDEX_NONE)
+		const int KeyIndex = KeySlot.KeyIndex;
+
+		bool bIsCollidingInputBox = false;
+		if (InputBox->EnhancedInputGroups.Contains(-1) ||
+			InputBoxes[i]->EnhancedInputGroups.Contains(-1))
 		{
-			bool bIsCollidingInputBox = false;
-			if (InputBox->EnhancedInputGroups.Contains(-1) ||
-				InputBoxes[i]->EnhancedInputGroups.Contains(-1))
-			{
-				bIsCollidingInputBox = true;
-			}
+			bIsCollidingInputBox = true;
+		}
 
-			if (!bIsCollidingInputBox)
+		if (!bIsCollidingInputBox)
+		{
+			for (int InputGroup : InputBox->EnhancedInputGroups)
 			{
-				for (int InputGroup : InputBox->EnhancedInputGroups)
+				if (InputBoxes[i]->EnhancedInputGroups.Contains(InputGroup))
 				{
-					if (InputBoxes[i]->EnhancedInputGroups.Contains(InputGroup))
-					{
-						bIsCollidingInputBox = true;
-						break;
-					}
+					bIsCollidingInputBox = true;
+					break;
 				}
 			}
+		}
 
-			if (bIsHold != InputBoxes[i]->bIsHoldInput[KeyIndex])
-			{
-				return true;
-			}
-
-			if (bIsCollidingInputBox)
-			{
-				OutCollidingActionIndex = i;
-				OutCollidingKeyIndex = KeyIndex;
-				return false;
-			}
-
+		if (bIsHold != InputBoxes[i]->bIsHoldInput[KeyIndex])
+		{
 			return true;
 		}
+
+		if (bIsCollidingInputBox)
+		{
+			OutCollidingActionIndex = i;
+			OutCollidingKeyIndex = KeyIndex;
+			return false;
+		}
+
+		return true;
 	}
 
 	return true;
@@ -300,6 +351,9 @@ void UUINavInputContainer::SwapKeysDecided(const UPromptDataBase* const PromptDa
 	{
 		if (SwapKeysPromptData->bShouldSwap)
 		{
+			UUINavLocalPlayerSubsystem* const UINavLocalPlayerSubsystem = ULocalPlayer::GetSubsystem<UUINavLocalPlayerSubsystem>(GetOwningLocalPlayer());
+			if (IsValid(UINavLocalPlayerSubsystem)) UINavLocalPlayerSubsystem->BeginInputRebindBatch();
+
 			const bool bWasCurrentInputBoxHold = SwapKeysPromptData->CurrentInputBox->bIsHoldInput[SwapKeysPromptData->InputCollisionData.CurrentKeyIndex];
 			const bool bWasCollidingInputBoxHold = SwapKeysPromptData->CollidingInputBox->bIsHoldInput[SwapKeysPromptData->InputCollisionData.CollidingKeyIndex];
 			FEnhancedActionKeyMapping* CurrentActionMapping = SwapKeysPromptData->CurrentInputBox->GetActionMapping(SwapKeysPromptData->InputCollisionData.CurrentKeyIndex);
@@ -314,6 +368,8 @@ void UUINavInputContainer::SwapKeysDecided(const UPromptDataBase* const PromptDa
 				true,
 				ModifiedActionMappingIndex,
 				CollidingInputBoxTrigger);
+
+			if (IsValid(UINavLocalPlayerSubsystem)) UINavLocalPlayerSubsystem->EndInputRebindBatch();
 		}
 		else
 		{
@@ -352,18 +408,14 @@ UUINavInputBox* UUINavInputContainer::GetInputBoxInDirection(UUINavInputBox* Inp
 
 UUINavInputBox* UUINavInputContainer::GetOppositeInputBox(const FInputContainerEnhancedActionData& ActionData)
 {
-	for (UUINavInputBox* InputBox : InputBoxes)
+	if (ActionData.AxisScale == EAxisType::None)
 	{
-		if (InputBox->InputActionData.Action == ActionData.Action &&
-			InputBox->InputActionData.Axis == ActionData.Axis &&
-			((InputBox->InputActionData.AxisScale == EAxisType::Positive && ActionData.AxisScale == EAxisType::Negative) ||
-			(InputBox->InputActionData.AxisScale == EAxisType::Negative && ActionData.AxisScale == EAxisType::Positive)))
-		{
-			return InputBox;
-		}
+		return nullptr;
 	}
 
-	return nullptr;
+	const EAxisType OppositeAxisScale = ActionData.AxisScale == EAxisType::Positive ? EAxisType::Negative : EAxisType::Positive;
+	const int32* const OppositeIndex = AxisScaleInputBoxes.Find(MakeTuple(static_cast<const UInputAction*>(ActionData.Action), ActionData.Axis, OppositeAxisScale));
+	return OppositeIndex != nullptr && InputBoxes.IsValidIndex(*OppositeIndex) ? InputBoxes[*OppositeIndex] : nullptr;
 }
 
 UUINavInputBox* UUINavInputContainer::GetOppositeInputBox(const FName& InputName, const EAxisType AxisType)
@@ -389,6 +441,45 @@ void UUINavInputContainer::GetInputRebindData(const int InputIndex, FInputRebind
 	}
 }
 
+void UUINavInputContainer::UpdateKeyOccupancy(const UUINavInputBox* const InputBox, const int KeyIndex, const FKey& OldKey, const FKey& NewKey)
+{
+	if (InputBox == nullptr || !InputBoxes.IsValidIndex(InputBox->ContainerIndex) || OldKey == NewKey)
+	{
+		return;
+	}
+
+	const int32 InputBoxIndex = InputBox->ContainerIndex;
+
+	if (OldKey.IsValid())
+	{
+		if (TArray<FInputBoxKeySlot>* const KeySlots = KeyOccupancy.Find(OldKey))
+		{
+			KeySlots->RemoveAll([InputBoxIndex, KeyIndex](const FInputBoxKeySlot& KeySlot)
+			{
+				return KeySlot.InputBoxIndex == InputBoxIndex && KeySlot.KeyIndex == KeyIndex;
+			});
+
+			if (KeySlots->Num() == 0)
+			{
+				KeyOccupancy.Remove(OldKey);
+			}
+		}
+	}
+
+	if (NewKey.IsValid())
+	{
+		TArray<FInputBoxKeySlot>& KeySlots = KeyOccupancy.FindOrAdd(NewKey);
+		int32 InsertIndex = 0;
+		while (InsertIndex < KeySlots.Num() &&
+			(KeySlots[InsertIndex].InputBoxIndex < InputBoxIndex ||
+			(KeySlots[InsertIndex].InputBoxIndex == InputBoxIndex && KeySlots[InsertIndex].KeyIndex < KeyIndex)))
+		{
+			++InsertIndex;
+		}
+		KeySlots.Insert({ InputBoxIndex, KeyIndex }, InsertIndex);
+	}
+}
+
 void UUINavInputContainer::GetEnhancedInputRebindData(const int InputIndex, FInputRebindData& RebindData) const
 {
 	if (InputBoxes.IsValidIndex(InputIndex))
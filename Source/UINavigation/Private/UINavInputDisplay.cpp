@@ -4,6 +4,8 @@
 #include "UINavInputDisplay.h"
 #include "GameFramework/PlayerController.h"
 #include "UINavPCComponent.h"
+#include "UINavLocalPlayerSubsystem.h"
+#include "Engine/LocalPlayer.h"
 #include "Engine/Texture2D.h"
 #include "Components/Image.h"
 #include "Components/TextBlock.h"
@@ -28,24 +30,22 @@ void UUINavInputDisplay::NativeConstruct()
 		return;
 	}
 
-	if (InputTypeRestriction == EInputRestriction::None)
-	{
-		UINavPC->UpdateInputIconsDelegate.AddDynamic(this, &UUINavInputDisplay::UpdateInputVisuals);
-	}
+	UINavPC->RegisterInputDisplay(this);
 	
 	UpdateInputVisuals();
 }
 
 void UUINavInputDisplay::NativeDestruct()
 {
-	if (!IsValid(UINavPC))
+	if (UUINavLocalPlayerSubsystem* const UINavLocalPlayerSubsystem = ULocalPlayer::GetSubsystem<UUINavLocalPlayerSubsystem>(GetOwningLocalPlayer()))
 	{
-		return;
+		UINavLocalPlayerSubsystem->SavedInputContextsAppliedDelegate.RemoveAll(this);
 	}
 
-	if (InputTypeRestriction == EInputRestriction::None)
+	if (IsValid(UINavPC))
 	{
-		UINavPC->UpdateInputIconsDelegate.RemoveDynamic(this, &UUINavInputDisplay::UpdateInputVisuals);
+		UINavPC->UnregisterInputDisplay(this);
+		UINavPC = nullptr;
 	}
 
 	Super::NativeDestruct();
@@ -106,9 +106,13 @@ void UUINavInputDisplay::UpdateInputVisuals()
 		return;
 	}
 
-	if (IsValid(InputText)) InputText->SetVisibility(ESlateVisibility::Collapsed);
-	if (IsValid(InputRichText)) InputRichText->SetVisibility(ESlateVisibility::Collapsed);
-	InputImage->SetVisibility(ESlateVisibility::Collapsed);
+	UUINavLocalPlayerSubsystem* const UINavLocalPlayerSubsystem = ULocalPlayer::GetSubsystem<UUINavLocalPlayerSubsystem>(GetOwningLocalPlayer());
+	if (IsValid(UINavLocalPlayerSubsystem) && !UINavLocalPlayerSubsystem->AreSavedInputContextsApplied())
+	{
+		// Avoid showing a key that's about to be replaced by the player's saved mappings
+		UINavLocalPlayerSubsystem->SavedInputContextsAppliedDelegate.AddUniqueDynamic(this, &UUINavInputDisplay::OnSavedInputContextsApplied);
+		return;
+	}
 
 	EInputRestriction Restriction = InputTypeRestriction;
 	if(Restriction == EInputRestriction::None)
@@ -116,9 +120,36 @@ void UUINavInputDisplay::UpdateInputVisuals()
 		Restriction = UINavPC->IsUsingGamepad() ? EInputRestriction::Gamepad : EInputRestriction::Keyboard_Mouse;
 	}
 
+	const FKey Key = UINavPC->GetEnhancedInputKey(InputAction, Axis, Scale, Restriction);
 	TSoftObjectPtr<UTexture2D> NewSoftTexture = GetDefault<UUINavSettings>()->bLoadInputIconsAsync ?
-		UINavPC->GetSoftEnhancedInputIcon(InputAction, Axis, Scale, Restriction) : UINavPC->GetEnhancedInputIcon(InputAction, Axis, Scale, Restriction);
-		
+		UINavPC->GetSoftKeyIcon(Key) : UINavPC->GetKeyIcon(Key);
+
+	ApplyInputVisuals(Key, NewSoftTexture, UINavPC->GetKeyText(Key));
+}
+
+void UUINavInputDisplay::OnSavedInputContextsApplied()
+{
+	if (UUINavLocalPlayerSubsystem* const UINavLocalPlayerSubsystem = ULocalPlayer::GetSubsystem<UUINavLocalPlayerSubsystem>(GetOwningLocalPlayer()))
+	{
+		UINavLocalPlayerSubsystem->SavedInputContextsAppliedDelegate.RemoveAll(this);
+	}
+
+	UpdateInputVisuals();
+}
+
+void UUINavInputDisplay::ApplyInputVisuals(const FKey& Key, const TSoftObjectPtr<UTexture2D>& NewSoftTexture, const FText& InputRawText)
+{
+	if (!IsValid(InputImage))
+	{
+		return;
+	}
+
+	DisplayedKey = Key;
+
+	if (IsValid(InputText)) InputText->SetVisibility(ESlateVisibility::Collapsed);
+	if (IsValid(InputRichText)) InputRichText->SetVisibility(ESlateVisibility::Collapsed);
+	InputImage->SetVisibility(ESlateVisibility::Collapsed);
+
 	if (!NewSoftTexture.IsNull() && DisplayType != EInputDisplayType::Text)
 	{
 		InputImage->SetBrushFromSoftTexture(NewSoftTexture, bMatchIconSize);
@@ -131,7 +162,6 @@ void UUINavInputDisplay::UpdateInputVisuals()
 	}
 	if (NewSoftTexture.IsNull() || DisplayType != EInputDisplayType::Icon)
 	{
-		const FText InputRawText = UINavPC->GetEnhancedInputText(InputAction, Axis, Scale, Restriction);
 		if (IsValid(InputText))
 		{
 			InputText->SetText(InputRawText);
@@ -148,10 +178,21 @@ void UUINavInputDisplay::UpdateInputVisuals()
 
 void UUINavInputDisplay::SetInputAction(UInputAction* NewAction, const EInputAxis NewAxis, const EAxisType NewScale)
 {
+	// The UINavPC groups displays by their input, so the registration has to follow the change
+	if (IsValid(UINavPC))
+	{
+		UINavPC->UnregisterInputDisplay(this);
+	}
+
 	InputAction = NewAction;
 	Axis = NewAxis;
 	Scale = NewScale;
 
+	if (IsValid(UINavPC))
+	{
+		UINavPC->RegisterInputDisplay(this);
+	}
+
 	UpdateInputVisuals();
 }
 
@@ -2,14 +2,201 @@
 
 #include "UINavInputProcessor.h"
 #include "UINavPCComponent.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameViewportClient.h"
+#include "GameFramework/PlayerController.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Application/SlateUser.h"
+#include "Widgets/SWindow.h"
+
+TSharedPtr<FUINavInputProcessor> FUINavInputProcessor::SharedInstance;
+
+TSharedRef<FUINavInputProcessor> FUINavInputProcessor::RegisterUINavPC(UUINavPCComponent* const UINavPC)
+{
+	if (!SharedInstance.IsValid())
+	{
+		SharedInstance = MakeShareable(new FUINavInputProcessor());
+		FSlateApplication::Get().RegisterInputPreProcessor(SharedInstance);
+	}
+
+	if (SharedInstance->FindRegisteredUINavPC(UINavPC) == nullptr)
+	{
+		FRegisteredUINavPC& RegisteredUINavPC = SharedInstance->RegisteredUINavPCs.AddDefaulted_GetRef();
+		RegisteredUINavPC.UINavPC = UINavPC;
+		RegisteredUINavPC.SlateUserIndex = GetSlateUserIndex(UINavPC);
+		RegisteredUINavPC.ViewportWindow = GetViewportWindow(UINavPC);
+	}
+
+	return SharedInstance.ToSharedRef();
+}
+
+void FUINavInputProcessor::UnregisterUINavPC(UUINavPCComponent* const UINavPC)
+{
+	if (!SharedInstance.IsValid())
+	{
+		return;
+	}
+
+	SharedInstance->RegisteredUINavPCs.RemoveAll([UINavPC](const FRegisteredUINavPC& RegisteredUINavPC)
+	{
+		return !RegisteredUINavPC.UINavPC.IsValid() || RegisteredUINavPC.UINavPC.Get() == UINavPC;
+	});
+
+	if (SharedInstance->RegisteredUINavPCs.Num() == 0)
+	{
+		if (FSlateApplication::IsInitialized())
+		{
+			FSlateApplication::Get().UnregisterInputPreProcessor(SharedInstance);
+		}
+		SharedInstance.Reset();
+	}
+}
+
+int32 FUINavInputProcessor::GetSlateUserIndex(const UUINavPCComponent* const UINavPC)
+{
+	const APlayerController* const PC = IsValid(UINavPC) ? UINavPC->GetPC() : nullptr;
+	const ULocalPlayer* const LocalPlayer = IsValid(PC) ? PC->GetLocalPlayer() : nullptr;
+	if (LocalPlayer == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	const TSharedPtr<FSlateUser> SlateUser = LocalPlayer->GetSlateUser();
+	return SlateUser.IsValid() ? SlateUser->GetUserIndex() : INDEX_NONE;
+}
+
+TWeakPtr<SWindow> FUINavInputProcessor::GetViewportWindow(const UUINavPCComponent* const UINavPC)
+{
+	const APlayerController* const PC = IsValid(UINavPC) ? UINavPC->GetPC() : nullptr;
+	const ULocalPlayer* const LocalPlayer = IsValid(PC) ? PC->GetLocalPlayer() : nullptr;
+	const UGameViewportClient* const ViewportClient = LocalPlayer != nullptr ? LocalPlayer->ViewportClient.Get() : nullptr;
+	return ViewportClient != nullptr ? ViewportClient->GetWindow() : nullptr;
+}
+
+int32 FUINavInputProcessor::FindRegisteredUINavPCIndex(const FSlateApplication& SlateApp, const int32 UserIndex) const
+{
+	// A single local player receives every event, as it did before events were routed by user
+	if (RegisteredUINavPCs.Num() == 1)
+	{
+		return RegisteredUINavPCs[0].UINavPC.IsValid() ? 0 : INDEX_NONE;
+	}
+
+	int32 FoundIndex = INDEX_NONE;
+	TSharedPtr<SWindow> ActiveWindow;
+	bool bResolvedActiveWindow = false;
+	for (int32 i = 0; i < RegisteredUINavPCs.Num(); ++i)
+	{
+		const FRegisteredUINavPC& RegisteredUINavPC = RegisteredUINavPCs[i];
+		if (RegisteredUINavPC.SlateUserIndex != UserIndex || !RegisteredUINavPC.UINavPC.IsValid())
+		{
+			continue;
+		}
+
+		if (FoundIndex == INDEX_NONE)
+		{
+			FoundIndex = i;
+			continue;
+		}
+
+		// Several local players share this Slate user (e.g. multiple PIE clients in one process), so the one whose viewport is focused gets the event
+		if (!bResolvedActiveWindow)
+		{
+			bResolvedActiveWindow = true;
+			ActiveWindow = SlateApp.GetActiveTopLevelWindow();
+		}
+
+		if (ActiveWindow.IsValid() &&
+			RegisteredUINavPCs[FoundIndex].ViewportWindow.Pin() != ActiveWindow &&
+			RegisteredUINavPC.ViewportWindow.Pin() == ActiveWindow)
+		{
+			FoundIndex = i;
+		}
+	}
+
+	return FoundIndex;
+}
+
+UUINavPCComponent* FUINavInputProcessor::GetEventTarget(const FSlateApplication& SlateApp, const int32 UserIndex)
+{
+	const int32 Index = FindRegisteredUINavPCIndex(SlateApp, UserIndex);
+	if (Index == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	FRegisteredUINavPC& RegisteredUINavPC = RegisteredUINavPCs[Index];
+	++RegisteredUINavPC.NumInputEvents;
+	return RegisteredUINavPC.UINavPC.Get();
+}
+
+FUINavInputProcessor::FRegisteredUINavPC* FUINavInputProcessor::FindRegisteredUINavPC(const UUINavPCComponent* const UINavPC)
+{
+	return RegisteredUINavPCs.FindByPredicate([UINavPC](const FRegisteredUINavPC& RegisteredUINavPC)
+	{
+		return RegisteredUINavPC.UINavPC.Get() == UINavPC;
+	});
+}
+
+const FUINavInputProcessor::FRegisteredUINavPC* FUINavInputProcessor::FindRegisteredUINavPC(const UUINavPCComponent* const UINavPC) const
+{
+	return RegisteredUINavPCs.FindByPredicate([UINavPC](const FRegisteredUINavPC& RegisteredUINavPC)
+	{
+		return RegisteredUINavPC.UINavPC.Get() == UINavPC;
+	});
+}
+
+uint64 FUINavInputProcessor::GetNumInputEvents(const UUINavPCComponent* const UINavPC) const
+{
+	const FRegisteredUINavPC* const RegisteredUINavPC = FindRegisteredUINavPC(UINavPC);
+	return RegisteredUINavPC != nullptr ? RegisteredUINavPC->NumInputEvents : 0;
+}
+
+uint64 FUINavInputProcessor::GetNumCoalescedAnalogEvents(const UUINavPCComponent* const UINavPC) const
+{
+	const FRegisteredUINavPC* const RegisteredUINavPC = FindRegisteredUINavPC(UINavPC);
+	return RegisteredUINavPC != nullptr ? RegisteredUINavPC->NumCoalescedAnalogEvents : 0;
+}
 
 void FUINavInputProcessor::Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor)
 {
+	// Indexed, since processing analog input can register or unregister UINavPCs
+	for (int32 i = 0; i < RegisteredUINavPCs.Num(); ++i)
+	{
+		FRegisteredUINavPC& RegisteredUINavPC = RegisteredUINavPCs[i];
+		const TWeakObjectPtr<UUINavPCComponent> UINavPC = RegisteredUINavPC.UINavPC;
+		if (!UINavPC.IsValid())
+		{
+			RegisteredUINavPC.PendingAnalogEvents.Reset();
+			continue;
+		}
+
+		// Controllers can be reassigned to other local players at runtime
+		RegisteredUINavPC.SlateUserIndex = GetSlateUserIndex(UINavPC.Get());
+		RegisteredUINavPC.ViewportWindow = GetViewportWindow(UINavPC.Get());
+
+		if (RegisteredUINavPC.PendingAnalogEvents.Num() == 0)
+		{
+			continue;
+		}
+
+		const TMap<FKey, FAnalogInputEvent> PendingAnalogEvents = MoveTemp(RegisteredUINavPC.PendingAnalogEvents);
+		RegisteredUINavPC.PendingAnalogEvents.Reset();
+
+		for (const TPair<FKey, FAnalogInputEvent>& PendingAnalogEvent : PendingAnalogEvents)
+		{
+			if (!UINavPC.IsValid())
+			{
+				break;
+			}
+
+			UINavPC->ProcessAnalogInput(PendingAnalogEvent.Value);
+		}
+	}
 }
 
 bool FUINavInputProcessor::HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent)
 {
-	if (UINavPC != nullptr)
+	if (UUINavPCComponent* const UINavPC = GetEventTarget(SlateApp, InKeyEvent.GetUserIndex()))
 	{
 		UINavPC->HandleKeyDownEvent(SlateApp, InKeyEvent);
 	}
@@ -19,7 +206,7 @@ bool FUINavInputProcessor::HandleKeyDownEvent(FSlateApplication& SlateApp, const
 
 bool FUINavInputProcessor::HandleKeyUpEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent)
 {
-	if (UINavPC != nullptr)
+	if (UUINavPCComponent* const UINavPC = GetEventTarget(SlateApp, InKeyEvent.GetUserIndex()))
 	{
 		UINavPC->HandleKeyUpEvent(SlateApp, InKeyEvent);
 	}
@@ -29,9 +216,24 @@ bool FUINavInputProcessor::HandleKeyUpEvent(FSlateApplication& SlateApp, const F
 
 bool FUINavInputProcessor::HandleAnalogInputEvent(FSlateApplication& SlateApp, const FAnalogInputEvent& InAnalogInputEvent)
 {
-	if (UINavPC != nullptr)
+	if (UUINavPCComponent* const UINavPC = GetEventTarget(SlateApp, InAnalogInputEvent.GetUserIndex()))
 	{
 		UINavPC->HandleAnalogInputEvent(SlateApp, InAnalogInputEvent);
+
+		FRegisteredUINavPC* const RegisteredUINavPC = FindRegisteredUINavPC(UINavPC);
+		if (RegisteredUINavPC == nullptr)
+		{
+			return IInputProcessor::HandleAnalogInputEvent(SlateApp, InAnalogInputEvent);
+		}
+
+		// Only the latest value of each analog key matters, so the heavier processing is done once per tick
+		TMap<FKey, FAnalogInputEvent>& PendingAnalogEvents = RegisteredUINavPC->PendingAnalogEvents;
+		const int32 NumPendingAnalogEvents = PendingAnalogEvents.Num();
+		PendingAnalogEvents.Add(InAnalogInputEvent.GetKey(), InAnalogInputEvent);
+		if (PendingAnalogEvents.Num() == NumPendingAnalogEvents)
+		{
+			++RegisteredUINavPC->NumCoalescedAnalogEvents;
+		}
 	}
 
 	return IInputProcessor::HandleAnalogInputEvent(SlateApp, InAnalogInputEvent);
@@ -39,7 +241,7 @@ bool FUINavInputProcessor::HandleAnalogInputEvent(FSlateApplication& SlateApp, c
 
 bool FUINavInputProcessor::HandleMouseMoveEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent)
 {
-	if (UINavPC != nullptr)
+	if (UUINavPCComponent* const UINavPC = GetEventTarget(SlateApp, MouseEvent.GetUserIndex()))
 	{
 		UINavPC->HandleMouseMoveEvent(SlateApp, MouseEvent);
 	}
@@ -49,7 +251,7 @@ bool FUINavInputProcessor::HandleMouseMoveEvent(FSlateApplication& SlateApp, con
 
 bool FUINavInputProcessor::HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent)
 {
-	if (UINavPC != nullptr)
+	if (UUINavPCComponent* const UINavPC = GetEventTarget(SlateApp, MouseEvent.GetUserIndex()))
 	{
 		UINavPC->HandleMouseButtonDownEvent(SlateApp, MouseEvent);
 	}
@@ -59,7 +261,7 @@ bool FUINavInputProcessor::HandleMouseButtonDownEvent(FSlateApplication& SlateAp
 
 bool FUINavInputProcessor::HandleMouseButtonUpEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent)
 {
-	if (UINavPC != nullptr)
+	if (UUINavPCComponent* const UINavPC = GetEventTarget(SlateApp, MouseEvent.GetUserIndex()))
 	{
 		UINavPC->HandleMouseButtonUpEvent(SlateApp, MouseEvent);
 	}
@@ -69,7 +271,7 @@ bool FUINavInputProcessor::HandleMouseButtonUpEvent(FSlateApplication& SlateApp,
 
 bool FUINavInputProcessor::HandleMouseWheelOrGestureEvent(FSlateApplication& SlateApp, const FPointerEvent& InWheelEvent, const FPointerEvent* InGesture)
 {
-	if (UINavPC != nullptr)
+	if (UUINavPCComponent* const UINavPC = GetEventTarget(SlateApp, InWheelEvent.GetUserIndex()))
 	{
 		UINavPC->HandleMouseWheelOrGestureEvent(SlateApp, InWheelEvent, InGesture);
 	}
@@ -5,11 +5,294 @@
 #include "Engine/LocalPlayer.h"
 #include "Engine/World.h"
 #include "EnhancedInputSubsystems.h"
+#include "GameFramework/PlayerController.h"
+#include "UINavPCComponent.h"
 #include "UINavSavedInputSettings.h"
+#include "UINavDefaultInputSettings.h"
+#include "UINavInputSaveGame.h"
 #include "UINavSettings.h"
+#include "UINavMacros.h"
+#include "UINavigationConfig.h"
+#include "Data/UINavEnhancedActionKeyMapping.h"
 #include "InputMappingContext.h"
+#include "InputModifiers.h"
+#include "InputTriggers.h"
 #include "Subsystems/SubsystemCollection.h"
 #include "AssetRegistry/AssetData.h"
+#include "Async/Async.h"
+#include "Engine/AssetManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+namespace UINavInputDelta
+{
+	// Guards against reading corrupted data as a huge amount of mappings
+	static constexpr int32 MaxMappings = 4096;
+
+	// A trigger or modifier, which can't be saved as a path since it might have been created at runtime by a rebind
+	struct FSavedInstancedObject
+	{
+		FString ClassPath;
+		TArray<uint8> Properties;
+	};
+
+	struct FSavedMapping
+	{
+		int32 Index = INDEX_NONE;
+		FString ActionPath;
+		FString KeyName;
+		TArray<FSavedInstancedObject> Triggers;
+		TArray<FSavedInstancedObject> Modifiers;
+	};
+
+	/*
+	*	The changes of an input context relative to its default mappings.
+	*	Mappings are compared by position, so that rebinds (which change a mapping's key in place) keep the order of the mappings.
+	*/
+	struct FContextDelta
+	{
+		FSoftObjectPath InputContext;
+		int32 NumDefaultMappings = 0;
+		int32 NumMappings = 0;
+		TArray<FSavedMapping> ChangedMappings;
+	};
+
+	static void SerializeInstancedObjects(FArchive& Ar, TArray<FSavedInstancedObject>& Objects)
+	{
+		int32 NumObjects = Objects.Num();
+		Ar << NumObjects;
+		if (Ar.IsLoading())
+		{
+			if (NumObjects < 0 || NumObjects > MaxMappings)
+			{
+				Ar.SetError();
+				return;
+			}
+			Objects.SetNum(NumObjects);
+		}
+
+		for (FSavedInstancedObject& Object : Objects)
+		{
+			Ar << Object.ClassPath;
+			Ar << Object.Properties;
+		}
+	}
+
+	static void SerializeContextDelta(FArchive& Ar, FContextDelta& Delta)
+	{
+		int32 NumChangedMappings = Delta.ChangedMappings.Num();
+		Ar << Delta.NumDefaultMappings;
+		Ar << Delta.NumMappings;
+		Ar << NumChangedMappings;
+		if (Ar.IsLoading())
+		{
+			if (Delta.NumMappings < 0 || Delta.NumMappings > MaxMappings ||
+				NumChangedMappings < 0 || NumChangedMappings > Delta.NumMappings)
+			{
+				Ar.SetError();
+				return;
+			}
+			Delta.ChangedMappings.SetNum(NumChangedMappings);
+		}
+
+		for (FSavedMapping& Mapping : Delta.ChangedMappings)
+		{
+			Ar << Mapping.Index;
+			Ar << Mapping.ActionPath;
+			Ar << Mapping.KeyName;
+			SerializeInstancedObjects(Ar, Mapping.Triggers);
+			SerializeInstancedObjects(Ar, Mapping.Modifiers);
+
+			if (Ar.IsError())
+			{
+				return;
+			}
+		}
+	}
+
+	template<typename T>
+	static void SaveInstancedObjects(const TArray<TObjectPtr<T>>& Objects, TArray<FSavedInstancedObject>& OutSavedObjects)
+	{
+		for (T* const Object : Objects)
+		{
+			if (!IsValid(Object))
+			{
+				continue;
+			}
+
+			FSavedInstancedObject& SavedObject = OutSavedObjects.AddDefaulted_GetRef();
+			SavedObject.ClassPath = Object->GetClass()->GetPathName();
+
+			FMemoryWriter Writer(SavedObject.Properties);
+			FObjectAndNameAsStringProxyArchive Ar(Writer, false);
+			Object->SerializeScriptProperties(Ar);
+		}
+	}
+
+	template<typename T>
+	static TArray<T*> CreateInstancedObjects(const TArray<FSavedInstancedObject>& SavedObjects, UObject* Outer)
+	{
+		TArray<T*> Objects;
+		for (const FSavedInstancedObject& SavedObject : SavedObjects)
+		{
+			UClass* const Class = FSoftClassPath(SavedObject.ClassPath).ResolveClass();
+			if (Class == nullptr || !Class->IsChildOf(T::StaticClass()))
+			{
+				continue;
+			}
+
+			T* const Object = NewObject<T>(Outer, Class);
+			FMemoryReader Reader(SavedObject.Properties);
+			FObjectAndNameAsStringProxyArchive Ar(Reader, true);
+			Object->SerializeScriptProperties(Ar);
+			Objects.Add(Object);
+		}
+		return Objects;
+	}
+
+	template<typename T>
+	static TArray<T*> ResolveDefaultObjects(const TArray<TSoftObjectPtr<T>>& SoftObjects)
+	{
+		TArray<T*> Objects;
+		for (const TSoftObjectPtr<T>& SoftObject : SoftObjects)
+		{
+			if (T* const Object = SoftObject.Get())
+			{
+				Objects.Add(Object);
+			}
+		}
+		return Objects;
+	}
+
+	// Returns false if the input context's mappings are the same as its default mappings
+	static bool EncodeContextDelta(const UInputMappingContext& InputContext, const FInputMappingArray* DefaultMappings, TArray<uint8>& OutData)
+	{
+		const TArray<FEnhancedActionKeyMapping>& Mappings = InputContext.GetMappings();
+
+		FContextDelta Delta;
+		Delta.NumDefaultMappings = DefaultMappings != nullptr ? DefaultMappings->InputMappings.Num() : 0;
+		Delta.NumMappings = Mappings.Num();
+
+		for (int32 Index = 0; Index < Mappings.Num(); ++Index)
+		{
+			const FEnhancedActionKeyMapping& Mapping = Mappings[Index];
+			if (DefaultMappings != nullptr &&
+				DefaultMappings->InputMappings.IsValidIndex(Index) &&
+				DefaultMappings->InputMappings[Index] == FUINavEnhancedActionKeyMapping(Mapping))
+			{
+				continue;
+			}
+
+			FSavedMapping& SavedMapping = Delta.ChangedMappings.AddDefaulted_GetRef();
+			SavedMapping.Index = Index;
+			SavedMapping.ActionPath = FSoftObjectPath(Mapping.Action.Get()).ToString();
+			SavedMapping.KeyName = Mapping.Key.GetFName().ToString();
+			SaveInstancedObjects(Mapping.Triggers, SavedMapping.Triggers);
+			SaveInstancedObjects(Mapping.Modifiers, SavedMapping.Modifiers);
+		}
+
+		if (Delta.NumMappings == Delta.NumDefaultMappings && Delta.ChangedMappings.Num() == 0)
+		{
+			return false;
+		}
+
+		OutData.Reset();
+		FMemoryWriter Writer(OutData);
+		SerializeContextDelta(Writer, Delta);
+		return true;
+	}
+
+	static bool DecodeContextDelta(const FSoftObjectPath& InputContext, const TArray<uint8>& Data, FContextDelta& OutDelta)
+	{
+		OutDelta.InputContext = InputContext;
+
+		FMemoryReader Reader(Data);
+		SerializeContextDelta(Reader, OutDelta);
+		if (Reader.IsError())
+		{
+			return false;
+		}
+
+		int32 PreviousIndex = INDEX_NONE;
+		for (const FSavedMapping& Mapping : OutDelta.ChangedMappings)
+		{
+			if (Mapping.Index <= PreviousIndex || Mapping.Index >= OutDelta.NumMappings)
+			{
+				return false;
+			}
+			PreviousIndex = Mapping.Index;
+		}
+		return true;
+	}
+
+	/*
+	*	Makes the input context's mappings match the saved ones. Only the mappings that differ from the saved ones are written,
+	*	so this can be applied again to an input context that already has the saved mappings.
+	*/
+	static bool ApplyContextDelta(UInputMappingContext* InputContext, const FContextDelta& Delta, const FInputMappingArray* DefaultMappings)
+	{
+		const int32 NumDefaultMappings = DefaultMappings != nullptr ? DefaultMappings->InputMappings.Num() : 0;
+		if (NumDefaultMappings != Delta.NumDefaultMappings)
+		{
+			UE_LOG(LogUINavigation, Warning, TEXT("The default mappings of %s changed since its input changes were saved. Increment the CurrentInputVersion when the default inputs change."), *Delta.InputContext.ToString());
+			return false;
+		}
+
+		// UnmapKey might reorder the remaining mappings, which is fine since every position is checked below
+		while (InputContext->GetMappings().Num() > Delta.NumMappings)
+		{
+			const int32 NumMappings = InputContext->GetMappings().Num();
+			const FEnhancedActionKeyMapping& LastMapping = InputContext->GetMappings().Last();
+			InputContext->UnmapKey(LastMapping.Action, LastMapping.Key);
+			if (InputContext->GetMappings().Num() == NumMappings)
+			{
+				return false;
+			}
+		}
+
+		int32 ChangedIndex = 0;
+		for (int32 Index = 0; Index < Delta.NumMappings; ++Index)
+		{
+			const FSavedMapping* const SavedMapping = Delta.ChangedMappings.IsValidIndex(ChangedIndex) && Delta.ChangedMappings[ChangedIndex].Index == Index ?
+				&Delta.ChangedMappings[ChangedIndex++] :
+				nullptr;
+			const bool bHasMapping = Index < InputContext->GetMappings().Num();
+
+			if (SavedMapping != nullptr)
+			{
+				const UInputAction* const Action = Cast<UInputAction>(FSoftObjectPath(SavedMapping->ActionPath).ResolveObject());
+				const FKey Key(*SavedMapping->KeyName);
+				FEnhancedActionKeyMapping& Mapping = bHasMapping ? InputContext->GetMapping(Index) : InputContext->MapKey(Action, Key);
+				Mapping.Action = Action;
+				Mapping.Key = Key;
+				Mapping.Triggers = CreateInstancedObjects<UInputTrigger>(SavedMapping->Triggers, InputContext);
+				Mapping.Modifiers = CreateInstancedObjects<UInputModifier>(SavedMapping->Modifiers, InputContext);
+				continue;
+			}
+
+			if (Index >= NumDefaultMappings)
+			{
+				return false;
+			}
+
+			const FUINavEnhancedActionKeyMapping& DefaultMapping = DefaultMappings->InputMappings[Index];
+			if (bHasMapping && FUINavEnhancedActionKeyMapping(InputContext->GetMapping(Index)) == DefaultMapping)
+			{
+				continue;
+			}
+
+			FEnhancedActionKeyMapping& Mapping = bHasMapping ? InputContext->GetMapping(Index) : InputContext->MapKey(DefaultMapping.Action.Get(), DefaultMapping.Key);
+			Mapping.Action = DefaultMapping.Action.Get();
+			Mapping.Key = DefaultMapping.Key;
+			Mapping.Triggers = ResolveDefaultObjects(DefaultMapping.Triggers);
+			Mapping.Modifiers = ResolveDefaultObjects(DefaultMapping.Modifiers);
+		}
+
+		return true;
+	}
+}
 
 void UUINavLocalPlayerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -18,23 +301,228 @@ void UUINavLocalPlayerSubsystem::Initialize(FSubsystemCollectionBase& Collection
 	Collection.InitializeDependency<UEnhancedInputLocalPlayerSubsystem>();
 }
 
+void UUINavLocalPlayerSubsystem::Deinitialize()
+{
+	bPendingMappingsRebuild = false;
+
+	// Async saves might not finish before the game shuts down, so the last one is written synchronously
+	// after the one in flight, which would otherwise overwrite it with older data
+	if (InputSaveGameWrite.IsValid())
+	{
+		InputSaveGameWrite.Wait();
+		InputSaveGameWrite.Reset();
+		bWritingInputSaveGame = false;
+	}
+
+	if (DirtyInputContexts.Num() > 0)
+	{
+		WriteSavedInputContexts(/*bAsync*/ false);
+	}
+	else if (bPendingInputSaveGameWrite)
+	{
+		WriteInputSaveGame(/*bAsync*/ false);
+	}
+
+	if (SavedInputContextsHandle.IsValid())
+	{
+		SavedInputContextsHandle->CancelHandle();
+		SavedInputContextsHandle.Reset();
+	}
+
+	if (PendingInputChangesHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingInputChangesHandle);
+		PendingInputChangesHandle.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
 void UUINavLocalPlayerSubsystem::SaveInputContextState(UInputMappingContext* InputContext)
 {
+	if (!IsValid(InputContext))
+	{
+		return;
+	}
+
+	DirtyInputContexts.Add(InputContext);
+	LastInputChangeTime = FPlatformTime::Seconds();
+	SchedulePendingInputChanges();
+}
+
+void UUINavLocalPlayerSubsystem::NotifyInputContextChanged(UInputMappingContext* InputContext)
+{
+	// Keys looked up before the deferred rebuild must already come from the new mappings
+	FUINavigationConfig::InvalidateCachedConfigs();
+	if (UUINavPCComponent* const UINavPC = GetUINavPC())
+	{
+		UINavPC->InvalidateEnhancedInputKeyCache();
+	}
+
+	bPendingMappingsRebuild = true;
+	SaveInputContextState(InputContext);
+	SchedulePendingInputChanges();
+}
+
+void UUINavLocalPlayerSubsystem::BeginInputRebindBatch()
+{
+	++InputRebindBatchDepth;
+}
+
+void UUINavLocalPlayerSubsystem::EndInputRebindBatch()
+{
+	if (InputRebindBatchDepth > 0)
+	{
+		--InputRebindBatchDepth;
+	}
+}
+
+void UUINavLocalPlayerSubsystem::FlushPendingInputChanges()
+{
+	if (bPendingMappingsRebuild)
+	{
+		bPendingMappingsRebuild = false;
+		RebuildInputMappings();
+	}
+
+	if (DirtyInputContexts.Num() > 0)
+	{
+		WriteSavedInputContexts();
+	}
+}
+
+void UUINavLocalPlayerSubsystem::SchedulePendingInputChanges()
+{
+	if (!PendingInputChangesHandle.IsValid())
+	{
+		// The core ticker keeps ticking while the game is paused, which is when rebinding usually happens
+		PendingInputChangesHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UUINavLocalPlayerSubsystem::TickPendingInputChanges));
+	}
+}
+
+bool UUINavLocalPlayerSubsystem::TickPendingInputChanges(float DeltaTime)
+{
+	if (InputRebindBatchDepth > 0)
+	{
+		return true;
+	}
+
+	if (bPendingMappingsRebuild)
+	{
+		bPendingMappingsRebuild = false;
+		RebuildInputMappings();
+	}
+
+	if (DirtyInputContexts.Num() > 0 && FPlatformTime::Seconds() - LastInputChangeTime >= GetDefault<UUINavSettings>()->InputSaveDelay)
+	{
+		WriteSavedInputContexts();
+	}
+
+	if (bPendingMappingsRebuild || DirtyInputContexts.Num() > 0)
+	{
+		return true;
+	}
+
+	PendingInputChangesHandle.Reset();
+	return false;
+}
+
+void UUINavLocalPlayerSubsystem::RebuildInputMappings()
+{
+	UUINavPCComponent* const UINavPC = GetUINavPC();
+	if (IsValid(UINavPC))
+	{
+		UINavPC->RequestRebuildMappings();
+		UINavPC->RefreshNavigationKeys();
+		UINavPC->UpdateInputIconsDelegate.Broadcast();
+		return;
+	}
+
+	FUINavigationConfig::InvalidateCachedConfigs();
+	if (UEnhancedInputLocalPlayerSubsystem* EnhancedInputSubsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(GetLocalPlayer()))
+	{
+		EnhancedInputSubsystem->RequestRebuildControlMappings();
+	}
+}
+
+void UUINavLocalPlayerSubsystem::WriteSavedInputContexts(const bool bAsync /*= true*/)
+{
+	if (GetDefault<UUINavSettings>()->bSaveInputsToSaveGame)
+	{
+		if (bLoadingInputSaveGame)
+		{
+			// Writing now would drop the saved changes that are still being loaded
+			return;
+		}
+
+		const UUINavDefaultInputSettings* const DefaultInputSettings = GetDefault<UUINavDefaultInputSettings>();
+		for (const TWeakObjectPtr<UInputMappingContext>& WeakInputContext : DirtyInputContexts)
+		{
+			if (const UInputMappingContext* const InputContext = WeakInputContext.Get())
+			{
+				const FSoftObjectPath InputContextPath = FAssetData(InputContext).ToSoftObjectPath();
+				const FInputMappingArray* const DefaultMappings = DefaultInputSettings->DefaultEnhancedInputMappings.Find(TSoftObjectPtr<UInputMappingContext>(InputContextPath));
+
+				TArray<uint8> Data;
+				if (UINavInputDelta::EncodeContextDelta(*InputContext, DefaultMappings, Data))
+				{
+					InputContextDeltas.Add(InputContextPath, MoveTemp(Data));
+				}
+				else
+				{
+					InputContextDeltas.Remove(InputContextPath);
+				}
+			}
+		}
+		DirtyInputContexts.Reset();
+
+		WriteInputSaveGame(bAsync);
+		return;
+	}
+
 	UUINavSavedInputSettings* SavedUINavInputSettings = GetMutableDefault<UUINavSavedInputSettings>();
-	SavedUINavInputSettings->SavedEnhancedInputMappings.FindOrAdd(TSoftObjectPtr<UInputMappingContext>(FAssetData(InputContext).ToSoftObjectPath())) = InputContext->GetMappings();
+	for (const TWeakObjectPtr<UInputMappingContext>& WeakInputContext : DirtyInputContexts)
+	{
+		if (const UInputMappingContext* const InputContext = WeakInputContext.Get())
+		{
+			SavedUINavInputSettings->SavedEnhancedInputMappings.FindOrAdd(TSoftObjectPtr<UInputMappingContext>(FAssetData(InputContext).ToSoftObjectPath())) = InputContext->GetMappings();
+		}
+	}
+	DirtyInputContexts.Reset();
+
 	SavedUINavInputSettings->SaveConfig();
 }
 
+UUINavPCComponent* UUINavLocalPlayerSubsystem::GetUINavPC() const
+{
+	const ULocalPlayer* const LocalPlayer = GetLocalPlayer();
+	const APlayerController* const PC = IsValid(LocalPlayer) ? LocalPlayer->GetPlayerController(GetWorld()) : nullptr;
+	return IsValid(PC) ? PC->FindComponentByClass<UUINavPCComponent>() : nullptr;
+}
+
 void UUINavLocalPlayerSubsystem::ApplySavedInputContexts()
 {
 	UWorld* const World = GetWorld();
 	if (!IsValid(World))
 	{
+		FinishApplyingSavedInputContexts();
 		return;
 	}
 
 	UEnhancedInputLocalPlayerSubsystem* EnhancedInputSubsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(GetLocalPlayer());;
 	if (!IsValid(EnhancedInputSubsystem))
+	{
+		FinishApplyingSavedInputContexts();
+		return;
+	}
+
+	if (GetDefault<UUINavSettings>()->bSaveInputsToSaveGame)
+	{
+		LoadInputSaveGame();
+		return;
+	}
+
+	if (SavedInputContextsHandle.IsValid())
 	{
 		return;
 	}
@@ -46,14 +534,57 @@ void UUINavLocalPlayerSubsystem::ApplySavedInputContexts()
 		SavedUINavInputSettings->SavedEnhancedInputMappings.Reset();
 		SavedUINavInputSettings->SavedInputVersion = CurrentInputVersion;
 		SavedUINavInputSettings->SaveConfig();
+		FinishApplyingSavedInputContexts();
+		return;
+	}
+
+	TArray<FSoftObjectPath> PathsToLoad;
+	for (const TPair<TSoftObjectPtr<UInputMappingContext>, FInputMappingArray>& Entry : SavedUINavInputSettings->SavedEnhancedInputMappings)
+	{
+		if (Entry.Key.IsNull() || Entry.Value.InputMappings.Num() == 0)
+		{
+			continue;
+		}
+
+		PathsToLoad.AddUnique(Entry.Key.ToSoftObjectPath());
+		for (const FUINavEnhancedActionKeyMapping& SavedInputMapping : Entry.Value.InputMappings)
+		{
+			PathsToLoad.AddUnique(SavedInputMapping.Action.ToSoftObjectPath());
+			for (const TSoftObjectPtr<UInputModifier>& Modifier : SavedInputMapping.Modifiers)
+			{
+				PathsToLoad.AddUnique(Modifier.ToSoftObjectPath());
+			}
+			for (const TSoftObjectPtr<UInputTrigger>& Trigger : SavedInputMapping.Triggers)
+			{
+				PathsToLoad.AddUnique(Trigger.ToSoftObjectPath());
+			}
+		}
+	}
+	PathsToLoad.Remove(FSoftObjectPath());
+
+	if (PathsToLoad.Num() == 0)
+	{
+		FinishApplyingSavedInputContexts();
 		return;
 	}
 
+	// Everything is requested in a single batch, so that spawning the player doesn't block on each context's assets
+	SavedInputContextsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(PathsToLoad),
+		FStreamableDelegate::CreateUObject(this, &UUINavLocalPlayerSubsystem::ApplySavedInputMappings));
+}
+
+void UUINavLocalPlayerSubsystem::ApplySavedInputMappings()
+{
+	SavedInputContextsHandle.Reset();
+
+	const UUINavSavedInputSettings* const SavedUINavInputSettings = GetDefault<UUINavSavedInputSettings>();
 	for (const TPair<TSoftObjectPtr<UInputMappingContext>, FInputMappingArray>& Entry : SavedUINavInputSettings->SavedEnhancedInputMappings)
 	{
-		UInputMappingContext* InputContext = Entry.Key.LoadSynchronous();
+		UInputMappingContext* InputContext = Entry.Key.Get();
 
-		if (InputContext == nullptr)
+		// Contexts rebound while their saved mappings were loading keep their new mappings
+		if (InputContext == nullptr || DirtyInputContexts.Contains(InputContext))
 		{
 			continue;
 		}
@@ -65,23 +596,279 @@ void UUINavLocalPlayerSubsystem::ApplySavedInputContexts()
 
 		for (const FUINavEnhancedActionKeyMapping& SavedInputMapping : SavedMappings.InputMappings)
 		{
-			FEnhancedActionKeyMapping& NewMapping = InputContext->MapKey(SavedInputMapping.Action.LoadSynchronous(), SavedInputMapping.Key);
+			FEnhancedActionKeyMapping& NewMapping = InputContext->MapKey(SavedInputMapping.Action.Get(), SavedInputMapping.Key);
 
 			TArray<UInputModifier*> InputModifiers;
 			for (const TSoftObjectPtr<UInputModifier>& Modifier : SavedInputMapping.Modifiers)
 			{
-				InputModifiers.Add(Modifier.LoadSynchronous());
+				InputModifiers.Add(Modifier.Get());
 			}
 			NewMapping.Modifiers = InputModifiers;
 
 			TArray<UInputTrigger*> InputTriggers;
 			for (const TSoftObjectPtr<UInputTrigger>& Trigger : SavedInputMapping.Triggers)
 			{
-				InputTriggers.Add(Trigger.LoadSynchronous());
+				InputTriggers.Add(Trigger.Get());
 			}
 			NewMapping.Triggers = InputTriggers;
 		}
 	}
 
-	EnhancedInputSubsystem->RequestRebuildControlMappings();
+	RebuildInputMappings();
+	FinishApplyingSavedInputContexts();
+}
+
+void UUINavLocalPlayerSubsystem::FinishApplyingSavedInputContexts()
+{
+	bSavedInputContextsApplied = true;
+	SavedInputContextsAppliedDelegate.Broadcast();
+}
+
+void UUINavLocalPlayerSubsystem::ResetSavedInputContexts()
+{
+	// Saved mappings that are still being loaded or applied no longer apply
+	if (SavedInputContextsHandle.IsValid())
+	{
+		SavedInputContextsHandle->CancelHandle();
+		SavedInputContextsHandle.Reset();
+	}
+
+	if (GetDefault<UUINavSettings>()->bSaveInputsToSaveGame)
+	{
+		bLoadingInputSaveGame = false;
+		bInputSaveGameLoaded = true;
+		InputContextDeltas.Reset();
+		WriteInputSaveGame();
+	}
+
+	if (!bSavedInputContextsApplied)
+	{
+		FinishApplyingSavedInputContexts();
+	}
+}
+
+void UUINavLocalPlayerSubsystem::LoadInputSaveGame()
+{
+	if (bInputSaveGameLoaded)
+	{
+		ApplyInputContextDeltas();
+		return;
+	}
+
+	if (bLoadingInputSaveGame)
+	{
+		return;
+	}
+
+	bLoadingInputSaveGame = true;
+	UGameplayStatics::AsyncLoadGameFromSlot(
+		GetDefault<UUINavSettings>()->InputSaveGameSlotName,
+		GetInputSaveGameUserIndex(),
+		FAsyncLoadGameFromSlotDelegate::CreateUObject(this, &UUINavLocalPlayerSubsystem::OnInputSaveGameLoaded));
+}
+
+void UUINavLocalPlayerSubsystem::OnInputSaveGameLoaded(const FString& SlotName, const int32 UserIndex, USaveGame* SaveGame)
+{
+	if (!bLoadingInputSaveGame)
+	{
+		return;
+	}
+
+	bLoadingInputSaveGame = false;
+	bInputSaveGameLoaded = true;
+
+	const UUINavInputSaveGame* const InputSaveGame = Cast<UUINavInputSaveGame>(SaveGame);
+	if (InputSaveGame == nullptr)
+	{
+		FinishApplyingSavedInputContexts();
+		return;
+	}
+
+	if (InputSaveGame->FormatVersion != UUINavInputSaveGame::CurrentFormatVersion ||
+		InputSaveGame->InputVersion < GetDefault<UUINavSettings>()->CurrentInputVersion)
+	{
+		InputContextDeltas.Reset();
+		WriteInputSaveGame();
+		FinishApplyingSavedInputContexts();
+		return;
+	}
+
+	FMemoryReader Reader(InputSaveGame->InputMappingsData);
+	int32 NumInputContexts = 0;
+	Reader << NumInputContexts;
+	for (int32 i = 0; i < NumInputContexts && !Reader.IsError(); ++i)
+	{
+		FString InputContextPath;
+		TArray<uint8> Data;
+		Reader << InputContextPath;
+		Reader << Data;
+		if (!Reader.IsError())
+		{
+			InputContextDeltas.Add(FSoftObjectPath(InputContextPath), MoveTemp(Data));
+		}
+	}
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogUINavigation, Warning, TEXT("The input save game in slot %s is corrupted and was partially loaded"), *SlotName);
+	}
+
+	ApplyInputContextDeltas();
+}
+
+void UUINavLocalPlayerSubsystem::ApplyInputContextDeltas()
+{
+	TArray<UINavInputDelta::FContextDelta> Deltas;
+	TArray<FSoftObjectPath> PathsToLoad;
+	for (const TPair<FSoftObjectPath, TArray<uint8>>& Entry : InputContextDeltas)
+	{
+		// Contexts changed while the save game was loading are saved again with their current mappings
+		UInputMappingContext* const LoadedInputContext = Cast<UInputMappingContext>(Entry.Key.ResolveObject());
+		if (LoadedInputContext != nullptr && DirtyInputContexts.Contains(LoadedInputContext))
+		{
+			continue;
+		}
+
+		UINavInputDelta::FContextDelta& Delta = Deltas.AddDefaulted_GetRef();
+		if (!UINavInputDelta::DecodeContextDelta(Entry.Key, Entry.Value, Delta))
+		{
+			UE_LOG(LogUINavigation, Warning, TEXT("Failed to read the saved input changes of %s"), *Entry.Key.ToString());
+			Deltas.Pop();
+			continue;
+		}
+
+		PathsToLoad.AddUnique(Entry.Key);
+		for (const UINavInputDelta::FSavedMapping& SavedMapping : Delta.ChangedMappings)
+		{
+			PathsToLoad.AddUnique(FSoftObjectPath(SavedMapping.ActionPath));
+			for (const UINavInputDelta::FSavedInstancedObject& SavedObject : SavedMapping.Triggers)
+			{
+				PathsToLoad.AddUnique(FSoftClassPath(SavedObject.ClassPath));
+			}
+			for (const UINavInputDelta::FSavedInstancedObject& SavedObject : SavedMapping.Modifiers)
+			{
+				PathsToLoad.AddUnique(FSoftClassPath(SavedObject.ClassPath));
+			}
+		}
+	}
+
+	if (Deltas.Num() == 0)
+	{
+		FinishApplyingSavedInputContexts();
+		return;
+	}
+
+	if (SavedInputContextsHandle.IsValid())
+	{
+		SavedInputContextsHandle->CancelHandle();
+	}
+
+	SavedInputContextsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(PathsToLoad),
+		FStreamableDelegate::CreateWeakLambda(this, [this, Deltas = MoveTemp(Deltas)]()
+		{
+			SavedInputContextsHandle.Reset();
+
+			const UUINavDefaultInputSettings* const DefaultInputSettings = GetDefault<UUINavDefaultInputSettings>();
+			for (const UINavInputDelta::FContextDelta& Delta : Deltas)
+			{
+				UInputMappingContext* const InputContext = Cast<UInputMappingContext>(Delta.InputContext.ResolveObject());
+				if (!IsValid(InputContext) || DirtyInputContexts.Contains(InputContext))
+				{
+					continue;
+				}
+
+				const FInputMappingArray* const DefaultMappings = DefaultInputSettings->DefaultEnhancedInputMappings.Find(TSoftObjectPtr<UInputMappingContext>(Delta.InputContext));
+				UINavInputDelta::ApplyContextDelta(InputContext, Delta, DefaultMappings);
+			}
+
+			RebuildInputMappings();
+			FinishApplyingSavedInputContexts();
+		}));
+}
+
+void UUINavLocalPlayerSubsystem::WriteInputSaveGame(const bool bAsync /*= true*/)
+{
+	if (bAsync && bWritingInputSaveGame)
+	{
+		// Written again once the current save finishes, so saves never overlap
+		bPendingInputSaveGameWrite = true;
+		return;
+	}
+	bPendingInputSaveGameWrite = false;
+
+	UUINavInputSaveGame* const InputSaveGame = Cast<UUINavInputSaveGame>(UGameplayStatics::CreateSaveGameObject(UUINavInputSaveGame::StaticClass()));
+	if (!IsValid(InputSaveGame))
+	{
+		return;
+	}
+
+	InputSaveGame->InputVersion = GetDefault<UUINavSettings>()->CurrentInputVersion;
+
+	FMemoryWriter Writer(InputSaveGame->InputMappingsData);
+	int32 NumInputContexts = InputContextDeltas.Num();
+	Writer << NumInputContexts;
+	for (TPair<FSoftObjectPath, TArray<uint8>>& Entry : InputContextDeltas)
+	{
+		FString InputContextPath = Entry.Key.ToString();
+		Writer << InputContextPath;
+		Writer << Entry.Value;
+	}
+
+	const FString& SlotName = GetDefault<UUINavSettings>()->InputSaveGameSlotName;
+	if (!bAsync)
+	{
+		UGameplayStatics::SaveGameToSlot(InputSaveGame, SlotName, GetInputSaveGameUserIndex());
+		return;
+	}
+
+	// Serialized here and written on a worker thread like AsyncSaveGameToSlot does, but keeping the future so shutdown can wait for it
+	const TSharedRef<TArray<uint8>> SaveData = MakeShared<TArray<uint8>>();
+	if (!UGameplayStatics::SaveGameToMemory(InputSaveGame, *SaveData))
+	{
+		return;
+	}
+
+	bWritingInputSaveGame = true;
+	const int32 UserIndex = GetInputSaveGameUserIndex();
+	const TWeakObjectPtr<UUINavLocalPlayerSubsystem> WeakThis(this);
+	InputSaveGameWrite = Async(EAsyncExecution::TaskGraph, [SaveData, SlotName, UserIndex, WeakThis]()
+	{
+		const bool bSuccess = UGameplayStatics::SaveDataToSlot(*SaveData, SlotName, UserIndex);
+		AsyncTask(ENamedThreads::GameThread, [SlotName, UserIndex, WeakThis, bSuccess]()
+		{
+			if (UUINavLocalPlayerSubsystem* const Subsystem = WeakThis.Get())
+			{
+				Subsystem->OnInputSaveGameWritten(SlotName, UserIndex, bSuccess);
+			}
+		});
+		return bSuccess;
+	});
+}
+
+void UUINavLocalPlayerSubsystem::OnInputSaveGameWritten(const FString& SlotName, const int32 UserIndex, bool bSuccess)
+{
+	if (!bWritingInputSaveGame)
+	{
+		// Already waited for at shutdown
+		return;
+	}
+	bWritingInputSaveGame = false;
+	InputSaveGameWrite.Reset();
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogUINavigation, Warning, TEXT("Failed to save the input changes to slot %s"), *SlotName);
+	}
+
+	if (bPendingInputSaveGameWrite)
+	{
+		WriteInputSaveGame();
+	}
+}
+
+int32 UUINavLocalPlayerSubsystem::GetInputSaveGameUserIndex() const
+{
+	const ULocalPlayer* const LocalPlayer = GetLocalPlayer();
+	return IsValid(LocalPlayer) ? LocalPlayer->GetPlatformUserIndex() : 0;
 }
@@ -26,12 +26,14 @@
 #include "Framework/Application/SlateApplication.h"
 #include "Framework/Application/SlateUser.h"
 #include "TimerManager.h"
+#include "Misc/App.h"
 #include "InputCoreTypes.h"
 #include "EnhancedInputSubsystems.h"
 #include "EnhancedInputLibrary.h"
 #include "EnhancedPlayerInput.h"
 #include "EnhancedActionKeyMapping.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/AssetManager.h"
 #include "Templates/SharedPointer.h"
 #include "Engine/GameViewportClient.h"
 #include "Engine/World.h"
@@ -45,6 +47,11 @@
 #include "UObject/ConstructorHelpers.h"
 #include "InputKeyEventArgs.h"
 
+DECLARE_CYCLE_STAT(TEXT("UINavPC NavigateInDirection"), STAT_UINavPC_NavigateInDirection, STATGROUP_UINavigation);
+DECLARE_CYCLE_STAT(TEXT("UINavPC NotifyNavigatedTo"), STAT_UINavPC_NotifyNavigatedTo, STATGROUP_UINavigation);
+DECLARE_CYCLE_STAT(TEXT("UINavPC ForceUpdateAllInputDisplays"), STAT_UINavPC_ForceUpdateAllInputDisplays, STATGROUP_UINavigation);
+DECLARE_CYCLE_STAT(TEXT("UINavPC ProcessPendingInputDisplayUpdates"), STAT_UINavPC_ProcessPendingInputDisplayUpdates, STATGROUP_UINavigation);
+
 const FKey UUINavPCComponent::MouseUp("MouseUp");
 const FKey UUINavPCComponent::MouseDown("MouseDown");
 const FKey UUINavPCComponent::MouseRight("MouseRight");
@@ -54,6 +61,7 @@ bool UUINavPCComponent::bInitialized = false;
 UUINavPCComponent::UUINavPCComponent()
 {
 	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 	PrimaryComponentTick.bTickEvenWhenPaused = true;
 
 	bAutoActivate = true;
@@ -124,6 +132,11 @@ void UUINavPCComponent::BeginPlay()
 		UUINavLocalPlayerSubsystem* UINavLocalPlayerSubsystem = ULocalPlayer::GetSubsystem<UUINavLocalPlayerSubsystem>(PC->GetLocalPlayer());
 		if (IsValid(UINavLocalPlayerSubsystem)) UINavLocalPlayerSubsystem->ApplySavedInputContexts();
 
+		if (UEnhancedInputLocalPlayerSubsystem* EnhancedInputSubsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PC->GetLocalPlayer()))
+		{
+			EnhancedInputSubsystem->ControlMappingsRebuiltDelegate.AddUniqueDynamic(this, &UUINavPCComponent::OnControlMappingsRebuilt);
+		}
+
 		RefreshNavigationKeys();
 
 		if (IsValid(GetEnhancedInputComponent()))
@@ -156,13 +169,19 @@ void UUINavPCComponent::BeginPlay()
 			}
 		}
 		
-		SharedInputProcessor = MakeShareable(new FUINavInputProcessor());
-		SharedInputProcessor->SetUINavPC(this);
-		FSlateApplication::Get().RegisterInputPreProcessor(SharedInputProcessor);
+		SharedInputProcessor = FUINavInputProcessor::RegisterUINavPC(this);
 
 		CacheGameInputContexts();
 		TryResetDefaultInputs();
 
+		AcquireInputIconSet(CurrentInputType == EInputType::Gamepad);
+		bAcquiredInputIconSet = true;
+		if (FSlateApplication::Get().IsGamepadAttached())
+		{
+			AcquireInputIconSet(/*bGamepad*/ true);
+			bPrefetchingGamepadIcons = true;
+		}
+
 		IPlatformInputDeviceMapper& PlatformInputMapper = IPlatformInputDeviceMapper::Get();
 		if (!PlatformInputMapper.GetOnInputDeviceConnectionChange().IsBoundToObject(this))
 		{
@@ -175,8 +194,25 @@ void UUINavPCComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	if (PC != nullptr && PC->IsLocalController())
 	{
-		FSlateApplication::Get().UnregisterInputPreProcessor(SharedInputProcessor);
+		FUINavInputProcessor::UnregisterUINavPC(this);
+		SharedInputProcessor.Reset();
+
+		if (UEnhancedInputLocalPlayerSubsystem* EnhancedInputSubsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PC->GetLocalPlayer()))
+		{
+			EnhancedInputSubsystem->ControlMappingsRebuiltDelegate.RemoveDynamic(this, &UUINavPCComponent::OnControlMappingsRebuilt);
+		}
+
+		if (UUINavLocalPlayerSubsystem* const UINavLocalPlayerSubsystem = ULocalPlayer::GetSubsystem<UUINavLocalPlayerSubsystem>(PC->GetLocalPlayer()))
+		{
+			UINavLocalPlayerSubsystem->SavedInputContextsAppliedDelegate.RemoveDynamic(this, &UUINavPCComponent::OnSavedInputContextsApplied);
+		}
+	}
+
+	if (SlatePostTickHandle.IsValid() && FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().OnPostTick().Remove(SlatePostTickHandle);
 	}
+	SlatePostTickHandle.Reset();
 
 	if (GetDefault<UUINavSettings>()->bRemoveActiveWidgetsOnEndPlay && IsValid(ActiveWidget))
 	{
@@ -185,6 +221,16 @@ void UUINavPCComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	
 	IPlatformInputDeviceMapper::Get().GetOnInputDeviceConnectionChange().RemoveAll(this);
 
+	ClearWidgetPool();
+
+	if (CachedInputContextsHandle.IsValid())
+	{
+		CachedInputContextsHandle->CancelHandle();
+		CachedInputContextsHandle.Reset();
+	}
+
+	ReleaseAllInputIconSets();
+
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -192,6 +238,16 @@ void UUINavPCComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAct
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	if (PendingInputDisplayUpdates.Num() > 0)
+	{
+		ProcessPendingInputDisplayUpdates();
+	}
+
+	if (MovingSelectorWidgets.Num() > 0)
+	{
+		TickSelectorMovements(FApp::GetDeltaTime());
+	}
+
 	if (bChainNavigation)
 	{
 		switch (CountdownPhase)
@@ -272,12 +328,6 @@ void UUINavPCComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAct
 		bIgnoreFocusByNavigation = false;
 	}
 
-	if (UsingThumbstickAsMouse() != EThumbstickAsMouse::None != bUsingThumbstickAsMouse)
-	{
-		bUsingThumbstickAsMouse = !bUsingThumbstickAsMouse;
-		RefreshNavigationKeys();
-	}
-
 	if (InputCooldownTime > 0.f)
 	{
 		InputCooldownTime -= DeltaTime;
@@ -296,10 +346,15 @@ void UUINavPCComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAct
 			}
 		}
 	}
+
+	UpdateComponentTickEnabled();
 }
 
 void UUINavPCComponent::RequestRebuildMappings()
 {
+	FUINavigationConfig::InvalidateCachedConfigs();
+	InvalidateEnhancedInputKeyCache();
+
 	UEnhancedInputLibrary::ForEachSubsystem([](IEnhancedInputSubsystemInterface* Subsystem)
 	{
 		if (Subsystem)
@@ -396,6 +451,18 @@ void UUINavPCComponent::RemoveInputContext(const UInputMappingContext* const Con
 
 void UUINavPCComponent::OnControllerConnectionChanged(EInputDeviceConnectionState NewConnectionState, FPlatformUserId UserId, FInputDeviceId UserIndex)
 {
+	// Prefetch the gamepad icons while a controller is connected, so switching to it doesn't hitch
+	if (NewConnectionState == EInputDeviceConnectionState::Connected && !bPrefetchingGamepadIcons)
+	{
+		AcquireInputIconSet(/*bGamepad*/ true);
+		bPrefetchingGamepadIcons = true;
+	}
+	else if (NewConnectionState == EInputDeviceConnectionState::Disconnected && bPrefetchingGamepadIcons && !FSlateApplication::Get().IsGamepadAttached())
+	{
+		ReleaseInputIconSet(/*bGamepad*/ true);
+		bPrefetchingGamepadIcons = false;
+	}
+
 	IUINavPCReceiver::Execute_OnControllerConnectionChanged(GetOwner(), NewConnectionState == EInputDeviceConnectionState::Connected, static_cast<int32>(UserId), static_cast<int32>(UserIndex.GetId()));
 }
 
@@ -616,7 +683,13 @@ UUINavWidget* UUINavPCComponent::GetFirstCommonParent(UUINavWidget* const Widget
 
 void UUINavPCComponent::CacheGameInputContexts()
 {
-	if (CachedInputContexts.Num() == 0)
+	if (CachedInputContexts.Num() > 0 || CachedInputContextsHandle.IsValid())
+	{
+		return;
+	}
+
+	const TArray<TSoftObjectPtr<UInputMappingContext>>& RebindableInputContexts = GetDefault<UUINavSettings>()->RebindableInputContexts;
+	if (RebindableInputContexts.Num() == 0)
 	{
 		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 		TArray<FAssetData> AssetsData;
@@ -631,7 +704,62 @@ void UUINavPCComponent::CacheGameInputContexts()
 
 			CachedInputContexts.Add(InputContext);
 		}
+		return;
 	}
+
+	TArray<FSoftObjectPath> ContextsToLoad;
+	for (const TSoftObjectPtr<UInputMappingContext>& SoftInputContext : RebindableInputContexts)
+	{
+		if (!SoftInputContext.IsNull() && !SoftInputContext.IsValid())
+		{
+			ContextsToLoad.AddUnique(SoftInputContext.ToSoftObjectPath());
+		}
+	}
+
+	if (ContextsToLoad.Num() == 0)
+	{
+		OnGameInputContextsLoaded();
+		return;
+	}
+
+	CachedInputContextsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		ContextsToLoad,
+		FStreamableDelegate::CreateUObject(this, &UUINavPCComponent::OnGameInputContextsLoaded));
+}
+
+void UUINavPCComponent::OnGameInputContextsLoaded()
+{
+	CachedInputContextsHandle.Reset();
+
+	CachedInputContexts.Reset();
+	for (const TSoftObjectPtr<UInputMappingContext>& SoftInputContext : GetDefault<UUINavSettings>()->RebindableInputContexts)
+	{
+		const UInputMappingContext* const InputContext = SoftInputContext.Get();
+		if (IsValid(InputContext))
+		{
+			CachedInputContexts.AddUnique(InputContext);
+		}
+	}
+
+	InvalidateEnhancedInputKeyCache();
+
+	if (bPendingResetDefaultInputs)
+	{
+		bPendingResetDefaultInputs = false;
+		TryResetDefaultInputs();
+	}
+}
+
+const TArray<const UInputMappingContext*>& UUINavPCComponent::GetGameInputContexts() const
+{
+	// Keep the handle alive, the load callback resets CachedInputContextsHandle
+	const TSharedPtr<FStreamableHandle> LoadHandle = CachedInputContextsHandle;
+	if (LoadHandle.IsValid() && LoadHandle->IsLoadingInProgress())
+	{
+		LoadHandle->WaitUntilComplete();
+	}
+
+	return CachedInputContexts;
 }
 
 void UUINavPCComponent::TryResetDefaultInputs()
@@ -640,6 +768,13 @@ void UUINavPCComponent::TryResetDefaultInputs()
 	const uint8 CurrentInputVersion = GetDefault<UUINavSettings>()->CurrentInputVersion;
 	if (DefaultInputSettings->DefaultEnhancedInputMappings.Num() == 0 || CurrentInputVersion > DefaultInputSettings->DefaultInputVersion)
 	{
+		if (CachedInputContextsHandle.IsValid())
+		{
+			// The defaults are snapshotted once the input contexts finish loading
+			bPendingResetDefaultInputs = true;
+			return;
+		}
+
 		DefaultInputSettings->DefaultEnhancedInputMappings.Reset();
 		DefaultInputSettings->DefaultInputVersion = CurrentInputVersion;
 		for (const UInputMappingContext* const InputContext : CachedInputContexts)
@@ -652,6 +787,8 @@ void UUINavPCComponent::TryResetDefaultInputs()
 
 void UUINavPCComponent::InitPlatformData()
 {
+	InvalidateEnhancedInputKeyCache();
+
 	const FPlatformConfigData* const FoundPlatformData = GetDefault<UUINavSettings>()->PlatformConfigData.Find(UGameplayStatics::GetPlatformName());
 	if (FoundPlatformData != nullptr)
 	{
@@ -663,6 +800,8 @@ void UUINavPCComponent::InitPlatformData()
 		CurrentPlatformData.GamepadKeyNameData = GamepadKeyNameData;
 		CurrentPlatformData.bCanUseKeyboardMouse = true;
 	}
+
+	RebuildKeyDisplayCaches();
 }
 
 void UUINavPCComponent::ProcessRebind(const FKeyEvent& KeyEvent, const bool bIsHold /*= false*/)
@@ -754,6 +893,8 @@ void UUINavPCComponent::SetActiveWidget(UUINavWidget * NewActiveWidget)
 
 void UUINavPCComponent::NotifyNavigatedTo(UUINavWidget* NavigatedWidget)
 {
+	UINAV_SCOPE_STAT(STAT_UINavPC_NotifyNavigatedTo);
+
 	if (!IsValid(NavigatedWidget) || NavigatedWidget == ActiveSubWidget)
 	{
 		return;
@@ -820,6 +961,8 @@ void UUINavPCComponent::NotifyNavigatedTo(UUINavWidget* NavigatedWidget)
 		}
 	}
 
+	UpdateComponentTickEnabled();
+
 	if (!GetDefault<UUINavSettings>()->bUseFocusSystemNavigationInputs && !bWaitingForInputCooldown)
 	{
 		UInputMappingContext* TargetInputContext = GetUINavInputContext(NavigatedWidget);
@@ -849,6 +992,18 @@ UUINavWidget* UUINavPCComponent::GoToWidget(TSubclassOf<UUINavWidget> NewWidgetC
 	return GoToBuiltWidget(NewWidget, bRemoveParent, bDestroyParent, ZOrder);
 }
 
+UUINavWidget* UUINavPCComponent::GoToPooledWidget(TSubclassOf<UUINavWidget> NewWidgetClass, const bool bRemoveParent, const bool bDestroyParent, const int ZOrder)
+{
+	if (NewWidgetClass == nullptr)
+	{
+		DISPLAYERROR("GoToPooledWidget: No Widget Class found");
+		return nullptr;
+	}
+
+	UUINavWidget* NewWidget = AcquirePooledWidget(NewWidgetClass);
+	return GoToBuiltWidget(NewWidget, bRemoveParent, bDestroyParent, ZOrder);
+}
+
 UUINavWidget* UUINavPCComponent::GoToPromptWidget(TSubclassOf<UUINavPromptWidget> NewWidgetClass, const FPromptWidgetDecided& Event, const FText Title, const FText Message, const bool bRemoveParent, const int ZOrder)
 {
 	if (NewWidgetClass == nullptr)
@@ -884,6 +1039,123 @@ UUINavWidget* UUINavPCComponent::GoToBuiltWidget(UUINavWidget* NewWidget, const
 	return ActiveWidget->GoToBuiltWidget(NewWidget, bRemoveParent, bDestroyParent, ZOrder);
 }
 
+UUINavWidget* UUINavPCComponent::AcquirePooledWidget(TSubclassOf<UUINavWidget> WidgetClass)
+{
+	if (WidgetClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	FPooledUINavWidgets* const PooledWidgets = WidgetPool.Find(WidgetClass);
+	while (PooledWidgets != nullptr && PooledWidgets->Widgets.Num() > 0)
+	{
+		UUINavWidget* const PooledWidget = PooledWidgets->Widgets.Pop();
+		--NumPooledWidgets;
+		if (IsValid(PooledWidget))
+		{
+			++WidgetPoolStats.Hits;
+			return PooledWidget;
+		}
+	}
+
+	++WidgetPoolStats.Misses;
+	UUINavWidget* const NewWidget = CreateWidget<UUINavWidget>(PC, WidgetClass);
+	if (IsValid(NewWidget))
+	{
+		NewWidget->bPooled = true;
+	}
+	return NewWidget;
+}
+
+void UUINavPCComponent::ReleasePooledWidget(UUINavWidget* Widget)
+{
+	if (!IsValid(Widget) || !Widget->bPooled)
+	{
+		return;
+	}
+
+	FPooledUINavWidgets& PooledWidgets = WidgetPool.FindOrAdd(Widget->GetClass());
+	if (PooledWidgets.Widgets.Contains(Widget))
+	{
+		return;
+	}
+
+	const UUINavSettings* const UINavSettings = GetDefault<UUINavSettings>();
+	if (PooledWidgets.Widgets.Num() >= UINavSettings->MaxPooledWidgetsPerClass ||
+		NumPooledWidgets >= UINavSettings->MaxPooledWidgets)
+	{
+		Widget->bPooled = false;
+		++WidgetPoolStats.Discarded;
+		return;
+	}
+
+	Widget->ResetForPool();
+	PooledWidgets.Widgets.Add(Widget);
+	++NumPooledWidgets;
+	++WidgetPoolStats.Released;
+}
+
+void UUINavPCComponent::PrewarmWidgetPool(TSubclassOf<UUINavWidget> WidgetClass, const int32 Count)
+{
+	if (WidgetClass == nullptr || PC == nullptr)
+	{
+		return;
+	}
+
+	const UUINavSettings* const UINavSettings = GetDefault<UUINavSettings>();
+	FPooledUINavWidgets& PooledWidgets = WidgetPool.FindOrAdd(WidgetClass);
+	while (PooledWidgets.Widgets.Num() < Count &&
+		PooledWidgets.Widgets.Num() < UINavSettings->MaxPooledWidgetsPerClass &&
+		NumPooledWidgets < UINavSettings->MaxPooledWidgets)
+	{
+		UUINavWidget* const NewWidget = CreateWidget<UUINavWidget>(PC, WidgetClass);
+		if (!IsValid(NewWidget))
+		{
+			return;
+		}
+
+		NewWidget->bPooled = true;
+		PooledWidgets.Widgets.Add(NewWidget);
+		++NumPooledWidgets;
+	}
+}
+
+void UUINavPCComponent::ClearWidgetPool()
+{
+	for (TPair<TSubclassOf<UUINavWidget>, FPooledUINavWidgets>& PooledWidgets : WidgetPool)
+	{
+		for (UUINavWidget* const PooledWidget : PooledWidgets.Value.Widgets)
+		{
+			if (IsValid(PooledWidget))
+			{
+				PooledWidget->bPooled = false;
+			}
+		}
+	}
+
+	WidgetPool.Reset();
+	NumPooledWidgets = 0;
+}
+
+FUINavWidgetPoolStats UUINavPCComponent::GetWidgetPoolStats() const
+{
+	FUINavWidgetPoolStats Stats = WidgetPoolStats;
+	Stats.NumPooled = NumPooledWidgets;
+	return Stats;
+}
+
+void UUINavPCComponent::RecordOpenLatency(const double LatencySeconds, const uint64 LatencyFrames)
+{
+	const float LatencyMs = static_cast<float>(LatencySeconds * 1000.0);
+
+	OpenLatencyStats.LastLatency = LatencyMs;
+	OpenLatencyStats.LastLatencyFrames = static_cast<int32>(LatencyFrames);
+	OpenLatencyStats.MaxLatency = FMath::Max(OpenLatencyStats.MaxLatency, LatencyMs);
+	OpenLatencyStats.AverageLatency += (LatencyMs - OpenLatencyStats.AverageLatency) / ++OpenLatencyStats.NumSamples;
+
+	UE_LOG(LogUINavigation, Verbose, TEXT("UINavWidget became interactive %.2fms (%d frames) after being opened"), LatencyMs, OpenLatencyStats.LastLatencyFrames);
+}
+
 EThumbstickAsMouse UUINavPCComponent::UsingThumbstickAsMouse() const
 {
 	const EThumbstickAsMouse ActiveWidgetThumbstickAsMouse = IsValid(ActiveWidget) ? ActiveWidget->GetUseThumbstickAsMouse() : EThumbstickAsMouse::None;
@@ -939,30 +1211,30 @@ bool UUINavPCComponent::ShouldHideMouseCursor() const
 
 void UUINavPCComponent::RefreshNavigationKeys()
 {
-	if (bWaitingForInputCooldown)
-	{
-		FSlateApplication::Get().SetNavigationConfig(
-			MakeShared<FUINavigationConfig>(
-				/*UINavInputContext*/ nullptr,
-				/*bAllowDirectionalInput*/ false,
-				/*bAllowSectionInput*/ false,
-				/*bAllowSelectInput*/ false,
-				/*bAllowReturnInput*/ false,
-				/*bUseAnalogDirectionalInput*/ false,
-				/*bUsingThumbstickAsMouse*/ false));
-	}
-	else
-	{
-		FSlateApplication::Get().SetNavigationConfig(
-			MakeShared<FUINavigationConfig>(
-				GetUINavInputContext(ActiveWidget),
-				bAllowDirectionalInput,
-				bAllowSectionInput,
-				bAllowSelectInput,
-				bAllowReturnInput,
-				bUseAnalogDirectionalInput && UsingThumbstickAsMouse() != EThumbstickAsMouse::LeftThumbstick,
-				UsingThumbstickAsMouse() != EThumbstickAsMouse::None));
+	bUsingThumbstickAsMouse = UsingThumbstickAsMouse() != EThumbstickAsMouse::None;
+
+	const TSharedRef<FUINavigationConfig> NavConfig = bWaitingForInputCooldown ?
+		FUINavigationConfig::GetOrCreate(
+			/*UINavInputContext*/ nullptr,
+			/*bAllowDirectionalInput*/ false,
+			/*bAllowSectionInput*/ false,
+			/*bAllowSelectInput*/ false,
+			/*bAllowReturnInput*/ false,
+			/*bUseAnalogDirectionalInput*/ false,
+			/*bUsingThumbstickAsMouse*/ false) :
+		FUINavigationConfig::GetOrCreate(
+			GetUINavInputContext(ActiveWidget),
+			bAllowDirectionalInput,
+			bAllowSectionInput,
+			bAllowSelectInput,
+			bAllowReturnInput,
+			bUseAnalogDirectionalInput && UsingThumbstickAsMouse() != EThumbstickAsMouse::LeftThumbstick,
+			UsingThumbstickAsMouse() != EThumbstickAsMouse::None);
 
+	FSlateApplication& SlateApp = FSlateApplication::Get();
+	if (SlateApp.GetNavigationConfig() != NavConfig)
+	{
+		SlateApp.SetNavigationConfig(NavConfig);
 	}
 
 	if (IsValid(ActiveWidget) && !bWaitingForInputCooldown)
@@ -1017,6 +1289,12 @@ void UUINavPCComponent::SetGamepadInputDataTables(UDataTable* NewKeyIconTable, U
 {
 	CurrentPlatformData.GamepadKeyIconData = NewKeyIconTable;
 	CurrentPlatformData.GamepadKeyNameData = NewKeyNameTable;
+	RebuildKeyDisplayCaches();
+
+	if (GamepadIconSet.RefCount > 0)
+	{
+		StreamInputIconSet(/*bGamepad*/ true);
+	}
 
 	if (bUpdateInputDisplays && CurrentInputType == EInputType::Gamepad)
 	{
@@ -1028,6 +1306,12 @@ void UUINavPCComponent::SetKeyboardInputDataTables(UDataTable* NewKeyIconTable,
 {
 	KeyboardMouseKeyIconData = NewKeyIconTable;
 	KeyboardMouseKeyNameData = NewKeyNameTable;
+	RebuildKeyDisplayCaches();
+
+	if (KeyboardMouseIconSet.RefCount > 0)
+	{
+		StreamInputIconSet(/*bGamepad*/ false);
+	}
 
 	if (bUpdateInputDisplays && CurrentInputType != EInputType::Gamepad)
 	{
@@ -1045,6 +1329,14 @@ void UUINavPCComponent::InputKey(const FKey& Key, const EInputEvent Event, const
 
 void UUINavPCComponent::ForceUpdateAllInputDisplays(const bool bOnlyTopLevel /*= false*/)
 {
+	UINAV_SCOPE_STAT(STAT_UINavPC_ForceUpdateAllInputDisplays);
+
+	if (!bOnlyTopLevel)
+	{
+		RefreshInputDisplays(/*bForceUpdate*/ true);
+		return;
+	}
+
 	TArray<UUserWidget*> Widgets;
 	UWidgetBlueprintLibrary::GetAllWidgetsOfClass(this, Widgets, UUINavInputDisplay::StaticClass(), /*bTopLevel*/ bOnlyTopLevel);
 	for (UUserWidget* Widget : Widgets)
@@ -1059,8 +1351,144 @@ void UUINavPCComponent::ForceUpdateAllInputDisplays(const bool bOnlyTopLevel /*=
 	}
 }
 
+UUINavPCComponent::FEnhancedInputKeyQuery UUINavPCComponent::GetInputDisplayQuery(const UUINavInputDisplay* const InputDisplay)
+{
+	FEnhancedInputKeyQuery Query;
+	Query.Action = InputDisplay->GetInputAction();
+	Query.Axis = InputDisplay->GetAxis();
+	Query.Scale = InputDisplay->GetScale();
+	Query.InputRestriction = InputDisplay->InputTypeRestriction;
+	return Query;
+}
+
+void UUINavPCComponent::RegisterInputDisplay(UUINavInputDisplay* const InputDisplay)
+{
+	if (!IsValid(InputDisplay) || !IsValid(InputDisplay->GetInputAction()))
+	{
+		return;
+	}
+
+	InputDisplayGroups.FindOrAdd(GetInputDisplayQuery(InputDisplay)).Displays.AddUnique(InputDisplay);
+}
+
+bool UUINavPCComponent::UnregisterInputDisplay(UUINavInputDisplay* const InputDisplay)
+{
+	if (InputDisplay == nullptr)
+	{
+		return false;
+	}
+
+	PendingInputDisplayUpdates.Remove(InputDisplay);
+
+	const FEnhancedInputKeyQuery Query = GetInputDisplayQuery(InputDisplay);
+	FInputDisplayGroup* const Group = InputDisplayGroups.Find(Query);
+	if (Group == nullptr || Group->Displays.Remove(InputDisplay) == 0)
+	{
+		return false;
+	}
+
+	if (Group->Displays.Num() == 0)
+	{
+		InputDisplayGroups.Remove(Query);
+	}
+
+	return true;
+}
+
+void UUINavPCComponent::RefreshInputDisplays(const bool bForceUpdate /*= false*/)
+{
+	if (WaitForSavedInputContexts())
+	{
+		return;
+	}
+
+	const bool bLoadInputIconsAsync = GetDefault<UUINavSettings>()->bLoadInputIconsAsync;
+	const EInputRestriction CurrentRestriction = IsUsingGamepad() ? EInputRestriction::Gamepad : EInputRestriction::Keyboard_Mouse;
+
+	for (auto It = InputDisplayGroups.CreateIterator(); It; ++It)
+	{
+		FInputDisplayGroup& Group = It->Value;
+		Group.Displays.RemoveAll([](const TWeakObjectPtr<UUINavInputDisplay>& InputDisplay) { return !InputDisplay.IsValid(); });
+		if (Group.Displays.Num() == 0)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		const FEnhancedInputKeyQuery& Query = It->Key;
+		const EInputRestriction Restriction = Query.InputRestriction == EInputRestriction::None ? CurrentRestriction : Query.InputRestriction;
+		const FKey NewKey = GetEnhancedInputKey(Query.Action.ResolveObjectPtr(), Query.Axis, Query.Scale, Restriction);
+
+		const auto ResolveGroupVisuals = [&]()
+		{
+			Group.Key = NewKey;
+			Group.Icon = bLoadInputIconsAsync ? GetSoftKeyIcon(NewKey) : TSoftObjectPtr<UTexture2D>(GetKeyIcon(NewKey));
+			Group.Text = GetKeyText(NewKey);
+		};
+
+		// Displays still pending from an earlier throttled pass read the group's visuals when they're applied, so those must always match the current key
+		bool bResolvedVisuals = Group.Key != NewKey;
+		if (bResolvedVisuals)
+		{
+			ResolveGroupVisuals();
+		}
+
+		for (const TWeakObjectPtr<UUINavInputDisplay>& InputDisplay : Group.Displays)
+		{
+			if (!bForceUpdate && InputDisplay->GetDisplayedKey() == NewKey)
+			{
+				continue;
+			}
+
+			if (!bResolvedVisuals)
+			{
+				bResolvedVisuals = true;
+				ResolveGroupVisuals();
+			}
+
+			PendingInputDisplayUpdates.Add(InputDisplay);
+		}
+	}
+
+	ProcessPendingInputDisplayUpdates();
+	UpdateComponentTickEnabled();
+}
+
+void UUINavPCComponent::ProcessPendingInputDisplayUpdates()
+{
+	UINAV_SCOPE_STAT(STAT_UINavPC_ProcessPendingInputDisplayUpdates);
+
+	if (WaitForSavedInputContexts())
+	{
+		return;
+	}
+
+	const int32 MaxUpdates = GetDefault<UUINavSettings>()->MaxInputDisplayUpdatesPerFrame;
+	int32 NumUpdates = 0;
+	for (auto It = PendingInputDisplayUpdates.CreateIterator(); It && (MaxUpdates <= 0 || NumUpdates < MaxUpdates); ++It)
+	{
+		UUINavInputDisplay* const InputDisplay = It->Get();
+		It.RemoveCurrent();
+		if (!IsValid(InputDisplay))
+		{
+			continue;
+		}
+
+		const FInputDisplayGroup* const Group = InputDisplayGroups.Find(GetInputDisplayQuery(InputDisplay));
+		if (Group == nullptr)
+		{
+			continue;
+		}
+
+		InputDisplay->ApplyInputVisuals(Group->Key, Group->Icon, Group->Text);
+		++NumUpdates;
+	}
+}
+
 void UUINavPCComponent::HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent)
 {
+	UpdateUsingThumbstickAsMouse();
+
 	const bool bIsGamepadSelectKey = GamepadSelectKeys.Contains(InKeyEvent.GetKey());
 	const bool bIsGamepadKey = InKeyEvent.GetKey().IsGamepadKey();
 	const bool bShouldUnforceNavigation = !bUsingThumbstickAsMouse || !bIsGamepadSelectKey || !bIsGamepadKey;
@@ -1103,6 +1531,9 @@ void UUINavPCComponent::HandleAnalogInputEvent(FSlateApplication& SlateApp, cons
 		return;
 	}
 
+	// Slate's analog navigation for this same event runs right after the input processor, so the navigation config must be up to date now
+	UpdateUsingThumbstickAsMouse();
+
 	if (CurrentInputType != EInputType::Gamepad && FMath::Abs(InAnalogInputEvent.GetAnalogValue()) > GetDefault<UUINavSettings>()->AnalogInputChangeThreshold)
 	{
 		NotifyInputTypeChange(EInputType::Gamepad);
@@ -1137,6 +1568,14 @@ void UUINavPCComponent::HandleAnalogInputEvent(FSlateApplication& SlateApp, cons
 	{
 		LastPressedKey = UsedAnalogKey;
 	}
+}
+
+void UUINavPCComponent::ProcessAnalogInput(const FAnalogInputEvent& InAnalogInputEvent)
+{
+	if (!IsValid(ActiveWidget))
+	{
+		return;
+	}
 
 	const UWorld* const World = GetWorld();
 	if (!IsValid(World))
@@ -1171,6 +1610,7 @@ void UUINavPCComponent::HandleAnalogInputEvent(FSlateApplication& SlateApp, cons
 			RefreshNavigationKeys();
 		}
 		bReceivedAnalogInput = true;
+		UpdateComponentTickEnabled();
 	}
 
 	if (bScrollWithRightThumbstick &&
@@ -1207,6 +1647,16 @@ void UUINavPCComponent::HandleAnalogInputEvent(FSlateApplication& SlateApp, cons
 	}
 }
 
+uint64 UUINavPCComponent::GetNumInputEvents() const
+{
+	return SharedInputProcessor.IsValid() ? SharedInputProcessor->GetNumInputEvents(this) : 0;
+}
+
+uint64 UUINavPCComponent::GetNumCoalescedAnalogEvents() const
+{
+	return SharedInputProcessor.IsValid() ? SharedInputProcessor->GetNumCoalescedAnalogEvents(this) : 0;
+}
+
 void UUINavPCComponent::HandleMouseMoveEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent)
 {
 	if (MouseEvent.GetCursorDelta().SizeSquared() > 0.0f && (UsingThumbstickAsMouse() == EThumbstickAsMouse::None || !IsMovingThumbstick()))
@@ -1379,6 +1829,7 @@ void UUINavPCComponent::SetTimer(const EUINavigation TimerDirection)
 	TimerCounter = 0.f;
 	CallbackDirection = TimerDirection;
 	CountdownPhase = ECountdownPhase::First;
+	UpdateComponentTickEnabled();
 }
 
 void UUINavPCComponent::ClearNavigationTimer()
@@ -1388,6 +1839,132 @@ void UUINavPCComponent::ClearNavigationTimer()
 	TimerCounter = 0.f;
 	CallbackDirection = EUINavigation::Invalid;
 	CountdownPhase = ECountdownPhase::None;
+	UpdateComponentTickEnabled();
+}
+
+void UUINavPCComponent::UpdateComponentTickEnabled()
+{
+	if (PC == nullptr || !PC->IsLocalController())
+	{
+		return;
+	}
+
+	const bool bShouldTick =
+		PendingInputDisplayUpdates.Num() > 0 ||
+		MovingSelectorWidgets.Num() > 0 ||
+		InputCooldownTime > 0.f ||
+		bReceivedAnalogInput ||
+		ThumbstickDelta != FVector2D::ZeroVector ||
+		bIgnoreFocusByNavigation ||
+		(bChainNavigation && CountdownPhase != ECountdownPhase::None && IsValid(ActiveWidget));
+
+	if (IsComponentTickEnabled() != bShouldTick)
+	{
+		SetComponentTickEnabled(bShouldTick);
+	}
+}
+
+void UUINavPCComponent::UpdateUsingThumbstickAsMouse()
+{
+	if ((UsingThumbstickAsMouse() != EThumbstickAsMouse::None) != bUsingThumbstickAsMouse)
+	{
+		RefreshNavigationKeys();
+	}
+}
+
+void UUINavPCComponent::ScheduleWidgetUpdate(UUINavWidget* const UINavWidget)
+{
+	if (!IsValid(UINavWidget))
+	{
+		return;
+	}
+
+	ScheduledWidgetUpdates.Add(UINavWidget, GFrameCounter);
+
+	if (!SlatePostTickHandle.IsValid() && FSlateApplication::IsInitialized())
+	{
+		SlatePostTickHandle = FSlateApplication::Get().OnPostTick().AddUObject(this, &UUINavPCComponent::OnSlatePostTick);
+	}
+}
+
+void UUINavPCComponent::StartSelectorMovement(UUINavWidget* const UINavWidget)
+{
+	if (!IsValid(UINavWidget))
+	{
+		return;
+	}
+
+	MovingSelectorWidgets.AddUnique(UINavWidget);
+	UpdateComponentTickEnabled();
+}
+
+void UUINavPCComponent::CancelWidgetUpdates(UUINavWidget* const UINavWidget)
+{
+	ScheduledWidgetUpdates.Remove(UINavWidget);
+	MovingSelectorWidgets.Remove(UINavWidget);
+}
+
+void UUINavPCComponent::OnSlatePostTick(const float DeltaTime)
+{
+	// Slate has arranged and painted this frame, so widgets can run the steps that need their geometry.
+	// Steps scheduled by those steps (e.g. a child widget gaining navigation) are run in the same pass.
+	TSet<TWeakObjectPtr<UUINavWidget>> ProcessedWidgets;
+	TArray<TWeakObjectPtr<UUINavWidget>> ReadyWidgets;
+	do
+	{
+		ReadyWidgets.Reset();
+		for (const TPair<TWeakObjectPtr<UUINavWidget>, uint64>& ScheduledUpdate : ScheduledWidgetUpdates)
+		{
+			if (ProcessedWidgets.Contains(ScheduledUpdate.Key))
+			{
+				continue;
+			}
+
+			// Widgets that don't get any geometry (e.g. collapsed) aren't waited on for longer than a frame
+			const UUINavWidget* const UINavWidget = ScheduledUpdate.Key.Get();
+			if (!IsValid(UINavWidget) || UINavWidget->HasArrangedGeometry() || ScheduledUpdate.Value < GFrameCounter)
+			{
+				ReadyWidgets.Add(ScheduledUpdate.Key);
+			}
+		}
+
+		for (const TWeakObjectPtr<UUINavWidget>& WeakWidget : ReadyWidgets)
+		{
+			ScheduledWidgetUpdates.Remove(WeakWidget);
+			ProcessedWidgets.Add(WeakWidget);
+
+			UUINavWidget* const UINavWidget = WeakWidget.Get();
+			if (IsValid(UINavWidget) && UINavWidget->ProcessDeferredUpdates() && !ScheduledWidgetUpdates.Contains(WeakWidget))
+			{
+				ScheduledWidgetUpdates.Add(WeakWidget, GFrameCounter);
+			}
+		}
+	}
+	while (ReadyWidgets.Num() > 0);
+
+	if (ScheduledWidgetUpdates.Num() == 0 && SlatePostTickHandle.IsValid())
+	{
+		FSlateApplication::Get().OnPostTick().Remove(SlatePostTickHandle);
+		SlatePostTickHandle.Reset();
+	}
+}
+
+void UUINavPCComponent::TickSelectorMovements(const float DeltaTime)
+{
+	for (int32 i = MovingSelectorWidgets.Num() - 1; i >= 0; --i)
+	{
+		UUINavWidget* const UINavWidget = MovingSelectorWidgets[i].Get();
+		if (!IsValid(UINavWidget) || !UINavWidget->TickSelectorMovement(DeltaTime))
+		{
+			MovingSelectorWidgets.RemoveAt(i);
+		}
+	}
+}
+
+void UUINavPCComponent::SetIgnoreFocusByNavigation(const bool bIgnore)
+{
+	bIgnoreFocusByNavigation = bIgnore;
+	UpdateComponentTickEnabled();
 }
 
 bool UUINavPCComponent::IsWidgetActive(const UUINavWidget* const UINavWidget) const
@@ -1444,11 +2021,29 @@ bool UUINavPCComponent::IsWidgetChild(const UUINavWidget* const ParentWidget, co
 
 FKey UUINavPCComponent::GetEnhancedInputKey(const UInputAction* Action, const EInputAxis Axis, const EAxisType Scale, const EInputRestriction InputRestriction) const
 {
-	if (!IsValid(PC))
+	if (!IsValid(PC) || !IsValid(Action))
 	{
 		return FKey();
 	}
 
+	FEnhancedInputKeyQuery Query;
+	Query.Action = Action;
+	Query.Axis = Axis;
+	Query.Scale = Scale;
+	Query.InputRestriction = InputRestriction;
+
+	if (const FKey* const CachedKey = EnhancedInputKeyCache.Find(Query))
+	{
+		return *CachedKey;
+	}
+
+	const FKey Key = FindEnhancedInputKey(Action, Axis, Scale, InputRestriction);
+	EnhancedInputKeyCache.Add(Query, Key);
+	return Key;
+}
+
+FKey UUINavPCComponent::FindEnhancedInputKey(const UInputAction* Action, const EInputAxis Axis, const EAxisType Scale, const EInputRestriction InputRestriction) const
+{
 	if (UUINavBlueprintFunctionLibrary::IsUINavInputAction(Action))
 	{
 		const UInputMappingContext* const UINavInputContext = GetDefault<UUINavSettings>()->EnhancedInputContext.LoadSynchronous();
@@ -1486,7 +2081,7 @@ FKey UUINavPCComponent::GetEnhancedInputKey(const UInputAction* Action, const EI
 		}
 	}
 
-	for (const UInputMappingContext* const InputContext : CachedInputContexts)
+	for (const UInputMappingContext* const InputContext : GetGameInputContexts())
 	{
 		for (const FEnhancedActionKeyMapping& Mapping : InputContext->GetMappings())
 		{
@@ -1528,24 +2123,135 @@ UTexture2D* UUINavPCComponent::GetKeyIcon(const FKey Key) const
 
 TSoftObjectPtr<UTexture2D> UUINavPCComponent::GetSoftKeyIcon(const FKey Key) const
 {
-	FInputIconMapping* KeyIcon = nullptr;
+	const TSoftObjectPtr<UTexture2D>* const KeyIcon = KeyIconCache.Find(Key);
+	return KeyIcon != nullptr ? *KeyIcon : nullptr;
+}
 
-	if (Key.IsGamepadKey())
+void UUINavPCComponent::RebuildKeyDisplayCaches()
+{
+	KeyIconCache.Reset();
+	KeyTextCache.Reset();
+
+	// Gamepad keys are only looked up in the gamepad tables, and every other key in the keyboard and mouse tables
+	const auto AddTableRows = [this](const UDataTable* const IconTable, const UDataTable* const NameTable, const bool bGamepadKeys)
 	{
-		if (CurrentPlatformData.GamepadKeyIconData != nullptr && CurrentPlatformData.GamepadKeyIconData->GetRowMap().Contains(Key.GetFName()))
+		if (IconTable != nullptr)
 		{
-			KeyIcon = reinterpret_cast<FInputIconMapping*>(CurrentPlatformData.GamepadKeyIconData->GetRowMap()[Key.GetFName()]);
+			for (const TPair<FName, uint8*>& Row : IconTable->GetRowMap())
+			{
+				const FKey Key(Row.Key);
+				if (Key.IsGamepadKey() == bGamepadKeys)
+				{
+					KeyIconCache.Add(Key, reinterpret_cast<const FInputIconMapping*>(Row.Value)->InputIcon);
+				}
+			}
 		}
+
+		if (NameTable != nullptr)
+		{
+			for (const TPair<FName, uint8*>& Row : NameTable->GetRowMap())
+			{
+				const FKey Key(Row.Key);
+				if (Key.IsGamepadKey() == bGamepadKeys)
+				{
+					KeyTextCache.Add(Key, reinterpret_cast<const FInputNameMapping*>(Row.Value)->InputText);
+				}
+			}
+		}
+	};
+
+	AddTableRows(CurrentPlatformData.GamepadKeyIconData, CurrentPlatformData.GamepadKeyNameData, /*bGamepadKeys*/ true);
+	if (CurrentPlatformData.bCanUseKeyboardMouse)
+	{
+		AddTableRows(KeyboardMouseKeyIconData, KeyboardMouseKeyNameData, /*bGamepadKeys*/ false);
 	}
-	else
+}
+
+const UDataTable* UUINavPCComponent::GetInputIconTable(const bool bGamepad) const
+{
+	if (bGamepad)
+	{
+		return CurrentPlatformData.GamepadKeyIconData;
+	}
+
+	return CurrentPlatformData.bCanUseKeyboardMouse ? KeyboardMouseKeyIconData : nullptr;
+}
+
+void UUINavPCComponent::AcquireInputIconSet(const bool bGamepad)
+{
+	if (!GetDefault<UUINavSettings>()->bStreamInputIconSets)
+	{
+		return;
+	}
+
+	FInputIconSet& IconSet = GetInputIconSet(bGamepad);
+	if (IconSet.RefCount++ == 0)
+	{
+		StreamInputIconSet(bGamepad);
+	}
+}
+
+void UUINavPCComponent::ReleaseInputIconSet(const bool bGamepad)
+{
+	FInputIconSet& IconSet = GetInputIconSet(bGamepad);
+	if (IconSet.RefCount == 0 || --IconSet.RefCount > 0)
+	{
+		return;
+	}
+
+	if (IconSet.Handle.IsValid())
+	{
+		IconSet.Handle->ReleaseHandle();
+		IconSet.Handle.Reset();
+	}
+}
+
+void UUINavPCComponent::StreamInputIconSet(const bool bGamepad)
+{
+	FInputIconSet& IconSet = GetInputIconSet(bGamepad);
+
+	// Only release the previous icons after requesting the new ones, so icons shared by both tables stay loaded
+	const TSharedPtr<FStreamableHandle> PreviousHandle = IconSet.Handle;
+	IconSet.Handle.Reset();
+
+	TArray<FSoftObjectPath> IconPaths;
+	if (const UDataTable* const IconTable = GetInputIconTable(bGamepad))
 	{
-		if (CurrentPlatformData.bCanUseKeyboardMouse && KeyboardMouseKeyIconData != nullptr && KeyboardMouseKeyIconData->GetRowMap().Contains(Key.GetFName()))
+		IconPaths.Reserve(IconTable->GetRowMap().Num());
+		for (const TPair<FName, uint8*>& Row : IconTable->GetRowMap())
 		{
-			KeyIcon = reinterpret_cast<FInputIconMapping*>(KeyboardMouseKeyIconData->GetRowMap()[Key.GetFName()]);
+			const FInputIconMapping* const IconMapping = reinterpret_cast<const FInputIconMapping*>(Row.Value);
+			if (IconMapping != nullptr && !IconMapping->InputIcon.IsNull())
+			{
+				IconPaths.Add(IconMapping->InputIcon.ToSoftObjectPath());
+			}
 		}
 	}
 
-	return KeyIcon != nullptr ? KeyIcon->InputIcon : nullptr;
+	if (IconPaths.Num() > 0)
+	{
+		IconSet.Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(IconPaths));
+	}
+
+	if (PreviousHandle.IsValid())
+	{
+		PreviousHandle->ReleaseHandle();
+	}
+}
+
+void UUINavPCComponent::ReleaseAllInputIconSets()
+{
+	for (FInputIconSet* const IconSet : { &GamepadIconSet, &KeyboardMouseIconSet })
+	{
+		if (IconSet->Handle.IsValid())
+		{
+			IconSet->Handle->ReleaseHandle();
+		}
+		*IconSet = FInputIconSet();
+	}
+
+	bAcquiredInputIconSet = false;
+	bPrefetchingGamepadIcons = false;
 }
 
 UTexture2D* UUINavPCComponent::GetEnhancedInputIcon(const UInputAction* Action, const EInputAxis Axis, const EAxisType Scale, const EInputRestriction InputRestriction) const
@@ -1567,27 +2273,65 @@ FText UUINavPCComponent::GetKeyText(const FKey Key) const
 {
 	if (!Key.IsValid()) return FText();
 
-	FInputNameMapping* Keyname = nullptr;
+	const FText* const KeyText = KeyTextCache.Find(Key);
+	return KeyText != nullptr ? *KeyText : Key.GetDisplayName();
+}
 
-	if (Key.IsGamepadKey())
+void UUINavPCComponent::GetEnhancedInputKeys(const UInputAction* Action, TArray<FKey>& OutKeys)
+{
+	if (!IsValid(PC) || !IsValid(Action))
 	{
-		if (CurrentPlatformData.GamepadKeyNameData != nullptr && CurrentPlatformData.GamepadKeyNameData->GetRowMap().Contains(Key.GetFName()))
-		{
-			Keyname = reinterpret_cast<FInputNameMapping*>(CurrentPlatformData.GamepadKeyNameData->GetRowMap()[Key.GetFName()]);
-		}
+		return;
 	}
-	else
+
+	const TArray<FKey>* CachedKeys = EnhancedInputKeysCache.Find(Action);
+	if (CachedKeys == nullptr)
 	{
-		if (CurrentPlatformData.bCanUseKeyboardMouse && KeyboardMouseKeyNameData != nullptr && KeyboardMouseKeyNameData->GetRowMap().Contains(Key.GetFName()))
-		{
-			Keyname = reinterpret_cast<FInputNameMapping*>(KeyboardMouseKeyNameData->GetRowMap()[Key.GetFName()]);
-		}
+		TArray<FKey> ActionKeys;
+		FindEnhancedInputKeys(Action, ActionKeys);
+		CachedKeys = &EnhancedInputKeysCache.Add(Action, MoveTemp(ActionKeys));
 	}
 
-	return Keyname != nullptr ? Keyname->InputText : Key.GetDisplayName();
+	OutKeys.Append(*CachedKeys);
 }
 
-void UUINavPCComponent::GetEnhancedInputKeys(const UInputAction* Action, TArray<FKey>& OutKeys)
+void UUINavPCComponent::InvalidateEnhancedInputKeyCache()
+{
+	EnhancedInputKeyCache.Reset();
+	EnhancedInputKeysCache.Reset();
+}
+
+void UUINavPCComponent::OnControlMappingsRebuilt()
+{
+	InvalidateEnhancedInputKeyCache();
+	RefreshInputDisplays();
+}
+
+bool UUINavPCComponent::WaitForSavedInputContexts()
+{
+	UUINavLocalPlayerSubsystem* const UINavLocalPlayerSubsystem = IsValid(PC) ? ULocalPlayer::GetSubsystem<UUINavLocalPlayerSubsystem>(PC->GetLocalPlayer()) : nullptr;
+	if (!IsValid(UINavLocalPlayerSubsystem) || UINavLocalPlayerSubsystem->AreSavedInputContextsApplied())
+	{
+		return false;
+	}
+
+	// Avoid showing keys that are about to be replaced by the player's saved mappings
+	UINavLocalPlayerSubsystem->SavedInputContextsAppliedDelegate.AddUniqueDynamic(this, &UUINavPCComponent::OnSavedInputContextsApplied);
+	return true;
+}
+
+void UUINavPCComponent::OnSavedInputContextsApplied()
+{
+	if (UUINavLocalPlayerSubsystem* const UINavLocalPlayerSubsystem = IsValid(PC) ? ULocalPlayer::GetSubsystem<UUINavLocalPlayerSubsystem>(PC->GetLocalPlayer()) : nullptr)
+	{
+		UINavLocalPlayerSubsystem->SavedInputContextsAppliedDelegate.RemoveDynamic(this, &UUINavPCComponent::OnSavedInputContextsApplied);
+	}
+
+	InvalidateEnhancedInputKeyCache();
+	RefreshInputDisplays(/*bForceUpdate*/ true);
+}
+
+void UUINavPCComponent::FindEnhancedInputKeys(const UInputAction* Action, TArray<FKey>& OutKeys) const
 {
 	if (UUINavBlueprintFunctionLibrary::IsUINavInputAction(Action))
 	{
@@ -1610,7 +2354,7 @@ void UUINavPCComponent::GetEnhancedInputKeys(const UInputAction* Action, TArray<
 		return;
 	}
 
-	for (const UInputMappingContext* const InputContext : CachedInputContexts)
+	for (const UInputMappingContext* const InputContext : GetGameInputContexts())
 	{
 		for (const FEnhancedActionKeyMapping& Mapping : InputContext->GetMappings())
 		{
@@ -1873,6 +2617,14 @@ void UUINavPCComponent::NotifyInputTypeChange(const EInputType NewInputType, con
 {
 	const EInputType OldInputType = CurrentInputType;
 	CurrentInputType = NewInputType;
+
+	const bool bWasUsingGamepad = OldInputType == EInputType::Gamepad;
+	const bool bIsUsingGamepad = NewInputType == EInputType::Gamepad;
+	if (bAcquiredInputIconSet && bWasUsingGamepad != bIsUsingGamepad)
+	{
+		AcquireInputIconSet(bIsUsingGamepad);
+		ReleaseInputIconSet(bWasUsingGamepad);
+	}
 	if (ActiveWidget != nullptr)
 	{
 		if (bAttemptUnforceNavigation)
@@ -1891,6 +2643,7 @@ void UUINavPCComponent::NotifyInputTypeChange(const EInputType NewInputType, con
 	IUINavPCReceiver::Execute_OnInputChanged(GetOwner(), OldInputType, CurrentInputType);
 	InputTypeChangedDelegate.Broadcast(CurrentInputType);
 	UpdateInputIconsDelegate.Broadcast();
+	RefreshInputDisplays();
 }
 
 UEnhancedInputComponent* UUINavPCComponent::GetEnhancedInputComponent() const
@@ -1913,6 +2666,8 @@ UInputMappingContext* UUINavPCComponent::GetUINavInputContext(const UUINavWidget
 
 void UUINavPCComponent::NavigateInDirection(const EUINavigation InDirection, const int32 UserIndex /*= 0*/)
 {
+	UINAV_SCOPE_STAT(STAT_UINavPC_NavigateInDirection);
+
 	AllowDirection = InDirection;
 
 	if (!IsValid(ActiveWidget) || !IsValid(ActiveWidget->GetCurrentComponent()) || ActiveWidget->GetCurrentComponent()->GetCachedWidget() == nullptr)
@@ -2173,7 +2928,9 @@ FGuid UUINavPCComponent::GoToWidgetAsync(
 		bRemoveParent,
 		bDestroyParent,
 		ZOrder,
-		Priority
+		Priority,
+		false,
+		PC
 	);
 }
 
@@ -0,0 +1,309 @@
+// Copyright (C) 2023 Gonçalo Marques - All Rights Reserved
+
+#include "UINavSpatialIndex.h"
+#include "UINavComponent.h"
+#include "UINavMacros.h"
+#include "Components/Button.h"
+
+DECLARE_CYCLE_STAT(TEXT("UINavSpatialIndex Rebuild"), STAT_UINavSpatialIndex_Rebuild, STATGROUP_UINavigation);
+DECLARE_CYCLE_STAT(TEXT("UINavSpatialIndex FindNearestInDirection"), STAT_UINavSpatialIndex_FindNearestInDirection, STATGROUP_UINavigation);
+
+namespace UINavSpatialIndex
+{
+	// Pixels of overlap allowed between two components that are still considered to be one after the other
+	static constexpr float EdgeTolerance = 1.0f;
+
+	// How much more the perpendicular distance to a component weighs compared to the distance in the navigation direction
+	static constexpr float PerpendicularWeight = 2.0f;
+
+	static float GetMin(const FSlateRect& Rect, const int32 Axis)
+	{
+		return Axis == 0 ? Rect.Left : Rect.Top;
+	}
+
+	static float GetMax(const FSlateRect& Rect, const int32 Axis)
+	{
+		return Axis == 0 ? Rect.Right : Rect.Bottom;
+	}
+
+	static bool CanNavigateTo(const UUINavComponent* const Component)
+	{
+		return IsValid(Component) &&
+			IsValid(Component->NavButton) &&
+			Component->IsFocusable() &&
+			Component->CanBeNavigated();
+	}
+}
+
+void FUINavSpatialIndex::Rebuild(const TArray<UUINavComponent*>& Components)
+{
+	UINAV_SCOPE_STAT(STAT_UINavSpatialIndex_Rebuild);
+
+	Reset();
+
+	Entries.Reserve(Components.Num());
+	EntryIndices.Reserve(Components.Num());
+
+	float TotalExtent = 0.0f;
+	for (UUINavComponent* const Component : Components)
+	{
+		if (!IsValid(Component) || !IsValid(Component->NavButton))
+		{
+			continue;
+		}
+
+		const FSlateRect Rect = GetComponentRect(Component);
+		if (Rect.GetSize().IsNearlyZero())
+		{
+			bHasSkippedComponents = true;
+			continue;
+		}
+
+		EntryIndices.Add(Component, Entries.Num());
+		Entries.Add({ Component, Rect });
+		TotalExtent += Rect.GetSize().GetMax();
+	}
+
+	EntryQueryStamps.SetNumZeroed(Entries.Num());
+	QueryStamp = 0;
+
+	bDirty = false;
+	LastRebuildFrame = GFrameCounter;
+
+	if (Entries.Num() == 0)
+	{
+		return;
+	}
+
+	CellSize = FMath::Max(TotalExtent / Entries.Num(), 1.0f);
+
+	MinCell = FIntPoint(MAX_int32, MAX_int32);
+	MaxCell = FIntPoint(MIN_int32, MIN_int32);
+	for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		const FSlateRect& Rect = Entries[EntryIndex].Rect;
+		const FIntPoint FirstCell = GetCell(Rect.GetTopLeft());
+		const FIntPoint LastCell = GetCell(Rect.GetBottomRight());
+
+		MinCell = MinCell.ComponentMin(FirstCell);
+		MaxCell = MaxCell.ComponentMax(LastCell);
+
+		for (int32 Y = FirstCell.Y; Y <= LastCell.Y; ++Y)
+		{
+			for (int32 X = FirstCell.X; X <= LastCell.X; ++X)
+			{
+				Cells.FindOrAdd(FIntPoint(X, Y)).Add(EntryIndex);
+			}
+		}
+	}
+}
+
+void FUINavSpatialIndex::Reset()
+{
+	Entries.Reset();
+	EntryIndices.Reset();
+	Cells.Reset();
+	EntryQueryStamps.Reset();
+	QueryStamp = 0;
+	MinCell = FIntPoint::ZeroValue;
+	MaxCell = FIntPoint::ZeroValue;
+	CellSize = 1.0f;
+	bDirty = true;
+	bHasSkippedComponents = false;
+}
+
+bool FUINavSpatialIndex::NeedsRebuild() const
+{
+	// Components that weren't arranged yet are picked up again, at most once per frame
+	return bDirty || (bHasSkippedComponents && LastRebuildFrame != GFrameCounter);
+}
+
+bool FUINavSpatialIndex::IsEntryUpToDate(const UUINavComponent* Component) const
+{
+	const int32* const EntryIndex = EntryIndices.Find(Component);
+	if (EntryIndex == nullptr || !IsValid(Component) || !IsValid(Component->NavButton))
+	{
+		return false;
+	}
+
+	const FSlateRect& IndexedRect = Entries[*EntryIndex].Rect;
+	const FSlateRect CurrentRect = GetComponentRect(Component);
+	return FMath::IsNearlyEqual(IndexedRect.Left, CurrentRect.Left, 0.5f) &&
+		FMath::IsNearlyEqual(IndexedRect.Top, CurrentRect.Top, 0.5f) &&
+		FMath::IsNearlyEqual(IndexedRect.Right, CurrentRect.Right, 0.5f) &&
+		FMath::IsNearlyEqual(IndexedRect.Bottom, CurrentRect.Bottom, 0.5f);
+}
+
+UUINavComponent* FUINavSpatialIndex::FindNearestInDirection(const UUINavComponent* FromComponent, const EUINavigation Direction) const
+{
+	UINAV_SCOPE_STAT(STAT_UINavSpatialIndex_FindNearestInDirection);
+
+	using namespace UINavSpatialIndex;
+
+	const int32* const FromIndex = EntryIndices.Find(FromComponent);
+	if (FromIndex == nullptr)
+	{
+		return nullptr;
+	}
+
+	int32 PrimaryAxis;
+	int32 Sign;
+	switch (Direction)
+	{
+		case EUINavigation::Left:
+			PrimaryAxis = 0;
+			Sign = -1;
+			break;
+		case EUINavigation::Right:
+			PrimaryAxis = 0;
+			Sign = 1;
+			break;
+		case EUINavigation::Up:
+			PrimaryAxis = 1;
+			Sign = -1;
+			break;
+		case EUINavigation::Down:
+			PrimaryAxis = 1;
+			Sign = 1;
+			break;
+		default:
+			return nullptr;
+	}
+	const int32 PerpendicularAxis = 1 - PrimaryAxis;
+
+	const FSlateRect& FromRect = Entries[*FromIndex].Rect;
+	const float FromEdge = Sign > 0 ? GetMax(FromRect, PrimaryAxis) : GetMin(FromRect, PrimaryAxis);
+
+	const FIntPoint FromFirstCell = GetCell(FromRect.GetTopLeft());
+	const FIntPoint FromLastCell = GetCell(FromRect.GetBottomRight());
+	const FIntPoint EdgeCell = GetCell(FVector2D(FromEdge, FromEdge));
+	const int32 FromPerpendicularMin = FromFirstCell[PerpendicularAxis];
+	const int32 FromPerpendicularMax = FromLastCell[PerpendicularAxis];
+	const int32 PrimaryStart = EdgeCell[PrimaryAxis];
+	const int32 MaxStep = Sign > 0 ? MaxCell[PrimaryAxis] - PrimaryStart : PrimaryStart - MinCell[PrimaryAxis];
+	const int32 MaxCellsAway = FMath::Max(FromPerpendicularMin - MinCell[PerpendicularAxis], MaxCell[PerpendicularAxis] - FromPerpendicularMax);
+	if (MaxStep < 0)
+	{
+		return nullptr;
+	}
+
+	if (++QueryStamp == 0)
+	{
+		FMemory::Memzero(EntryQueryStamps.GetData(), EntryQueryStamps.Num() * sizeof(uint32));
+		QueryStamp = 1;
+	}
+	EntryQueryStamps[*FromIndex] = QueryStamp;
+
+	UUINavComponent* BestComponent = nullptr;
+	float BestScore = TNumericLimits<float>::Max();
+
+	auto VisitCell = [&](const int32 Step, const int32 PerpendicularCell, const int32 CellsAway)
+	{
+		if (PerpendicularCell < MinCell[PerpendicularAxis] || PerpendicularCell > MaxCell[PerpendicularAxis])
+		{
+			return;
+		}
+
+		// Every component in this cell is at least this far away
+		const float LowerBound = (FMath::Max(Step - 1, 0) + FMath::Max(CellsAway - 1, 0) * PerpendicularWeight) * CellSize;
+		if (BestComponent != nullptr && LowerBound > BestScore)
+		{
+			return;
+		}
+
+		const int32 PrimaryCell = PrimaryStart + Step * Sign;
+		const FIntPoint Cell = PrimaryAxis == 0 ? FIntPoint(PrimaryCell, PerpendicularCell) : FIntPoint(PerpendicularCell, PrimaryCell);
+		const TArray<int32>* const CellEntries = Cells.Find(Cell);
+		if (CellEntries == nullptr)
+		{
+			return;
+		}
+
+		for (const int32 EntryIndex : *CellEntries)
+		{
+			if (EntryQueryStamps[EntryIndex] == QueryStamp)
+			{
+				continue;
+			}
+			EntryQueryStamps[EntryIndex] = QueryStamp;
+
+			const FEntry& Entry = Entries[EntryIndex];
+			const float PrimaryGap = Sign > 0 ?
+				GetMin(Entry.Rect, PrimaryAxis) - FromEdge :
+				FromEdge - GetMax(Entry.Rect, PrimaryAxis);
+			if (PrimaryGap < -EdgeTolerance)
+			{
+				continue;
+			}
+
+			const float PerpendicularGap = FMath::Max3(
+				GetMin(Entry.Rect, PerpendicularAxis) - GetMax(FromRect, PerpendicularAxis),
+				GetMin(FromRect, PerpendicularAxis) - GetMax(Entry.Rect, PerpendicularAxis),
+				0.0f);
+
+			const float Score = FMath::Max(PrimaryGap, 0.0f) + PerpendicularGap * PerpendicularWeight;
+			if (Score >= BestScore)
+			{
+				continue;
+			}
+
+			UUINavComponent* const Component = Entry.Component.Get();
+			if (!CanNavigateTo(Component))
+			{
+				continue;
+			}
+
+			BestScore = Score;
+			BestComponent = Component;
+		}
+	};
+
+	// Expand outward from the component's cells in rings, where ring N holds the cells N steps ahead or N cells to the side
+	const int32 MaxRing = FMath::Max(MaxStep, MaxCellsAway);
+	for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+	{
+		// Every cell of this ring and the ones after it is at least this far away
+		if (BestComponent != nullptr && FMath::Max(Ring - 1, 0) * CellSize > BestScore)
+		{
+			break;
+		}
+
+		if (Ring <= MaxStep)
+		{
+			const int32 FirstCell = FMath::Max(FromPerpendicularMin - Ring, MinCell[PerpendicularAxis]);
+			const int32 LastCell = FMath::Min(FromPerpendicularMax + Ring, MaxCell[PerpendicularAxis]);
+			for (int32 PerpendicularCell = FirstCell; PerpendicularCell <= LastCell; ++PerpendicularCell)
+			{
+				const int32 CellsAway = PerpendicularCell < FromPerpendicularMin ?
+					FromPerpendicularMin - PerpendicularCell :
+					(PerpendicularCell > FromPerpendicularMax ? PerpendicularCell - FromPerpendicularMax : 0);
+				VisitCell(Ring, PerpendicularCell, CellsAway);
+			}
+		}
+
+		if (Ring > 0)
+		{
+			const int32 LastStep = FMath::Min(Ring - 1, MaxStep);
+			for (int32 Step = 0; Step <= LastStep; ++Step)
+			{
+				VisitCell(Step, FromPerpendicularMin - Ring, Ring);
+				VisitCell(Step, FromPerpendicularMax + Ring, Ring);
+			}
+		}
+	}
+
+	return BestComponent;
+}
+
+FSlateRect FUINavSpatialIndex::GetComponentRect(const UUINavComponent* Component)
+{
+	const FGeometry& Geometry = Component->NavButton->GetCachedGeometry();
+	const FVector2D Position = Geometry.GetAbsolutePosition();
+	const FVector2D Size = Geometry.GetAbsoluteSize();
+	return FSlateRect(Position, Position + Size);
+}
+
+FIntPoint FUINavSpatialIndex::GetCell(const FVector2D& Point) const
+{
+	return FIntPoint(FMath::FloorToInt(Point.X / CellSize), FMath::FloorToInt(Point.Y / CellSize));
+}
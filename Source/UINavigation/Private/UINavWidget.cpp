@@ -19,6 +19,7 @@
 #include "Blueprint/WidgetTree.h"
 #include "Blueprint/SlateBlueprintLibrary.h"
 #include "Blueprint/WidgetBlueprintLibrary.h"
+#include "Blueprint/WidgetBlueprintGeneratedClass.h"
 #include "Components/Border.h"
 #include "Components/TextBlock.h"
 #include "Components/HorizontalBox.h"
@@ -37,6 +38,50 @@
 #include "Kismet/GameplayStatics.h"
 #include "Engine/InputDelegateBinding.h"
 
+DECLARE_CYCLE_STAT(TEXT("UINavWidget Setup"), STAT_UINavWidget_UINavSetup, STATGROUP_UINavigation);
+DECLARE_CYCLE_STAT(TEXT("UINavWidget NavigatedTo"), STAT_UINavWidget_NavigatedTo, STATGROUP_UINavigation);
+
+/**
+* The widgets found by TraverseHierarchy and SetupSections for a UINavWidget class,
+* stored as name paths relative to the widget's WidgetTree so they can be resolved on other instances
+*/
+struct FUINavCachedWidgetPath
+{
+	TArray<FName> Path;
+
+	// An instance whose widget at this path has another class doesn't match the cached topology
+	TWeakObjectPtr<const UClass> WidgetClass;
+};
+
+struct FUINavWidgetTopology
+{
+	// Used to detect the widget blueprint being recompiled
+	TWeakObjectPtr<const UWidgetTree> WidgetTreeArchetype;
+
+	TArray<FUINavCachedWidgetPath> ChildUINavWidgetPaths;
+	TArray<FUINavCachedWidgetPath> SectionButtonPaths;
+	TArray<FUINavCachedWidgetPath> SectionWidgetPaths;
+	TArray<FName> FirstComponentPath;
+
+	bool bHasSections = false;
+
+	// Set when instances of the class were found with different trees (e.g. widgets added at runtime), in which case the topology isn't used
+	bool bDynamicTree = false;
+};
+
+static TMap<TWeakObjectPtr<const UClass>, FUINavWidgetTopology> CachedWidgetTopologies;
+
+static const UWidgetTree* GetWidgetTreeArchetype(const UClass* const WidgetClass)
+{
+	const UWidgetBlueprintGeneratedClass* const WidgetBPClass = Cast<UWidgetBlueprintGeneratedClass>(WidgetClass);
+	return WidgetBPClass != nullptr ? WidgetBPClass->GetWidgetTreeArchetype() : nullptr;
+}
+
+static bool IsTopologyStale(const TWeakObjectPtr<const UClass>& WidgetClass, const FUINavWidgetTopology& Topology)
+{
+	return !WidgetClass.IsValid() || Topology.WidgetTreeArchetype.Get() != GetWidgetTreeArchetype(WidgetClass.Get());
+}
+
 UUINavWidget::UUINavWidget(const FObjectInitializer& ObjectInitializer)
 	:Super(ObjectInitializer)
 {
@@ -60,6 +105,13 @@ void UUINavWidget::NativeConstruct()
 		}
 
 		ParentWidget = OuterUINavWidget;
+
+		//Widgets constructed after the outer widget traversed its hierarchy are added to it incrementally
+		if (OuterUINavWidget->bSetupStarted)
+		{
+			OuterUINavWidget->AddChildUINavWidget(this);
+		}
+
 		PreSetup(!bCompletedSetup);
 
 		ConfigureUINavPC();
@@ -89,6 +141,7 @@ void UUINavWidget::NativeConstruct()
 		if (bShouldDestroyParent)
 		{
 			ParentWidget = OuterParentWidget->ParentWidget;
+			OuterParentWidget->TryReleaseToPool();
 			OuterParentWidget = nullptr;
 		}
 	}
@@ -107,6 +160,9 @@ void UUINavWidget::NativeConstruct()
 		}
 	}
 
+	SetupStartTime = FPlatformTime::Seconds();
+	SetupStartFrame = GFrameCounter;
+
 	PreSetup(!bCompletedSetup);
 	InitialSetup();
 
@@ -132,9 +188,23 @@ void UUINavWidget::InitialSetup(const bool bRebuilding)
 		bSetupStarted = true;
 	}
 
-	TraverseHierarchy();
+	FUINavWidgetTopology* const CachedTopology = FindCachedTopology();
+	if (CachedTopology == nullptr || !ApplyCachedTopology(*CachedTopology))
+	{
+		ChildUINavWidgets.Reset();
+		SectionButtons.Reset();
+		SectionWidgets.Reset();
 
-	SetupSections();
+		TraverseHierarchy();
+		SetupSections();
+
+		CacheTopology();
+	}
+	else
+	{
+		//The sections were already found and validated through the cached topology
+		BindSectionButtons();
+	}
 
 	//If this widget doesn't need to create the selector, skip to setup
 	if (!IsSelectorValid())
@@ -144,7 +214,8 @@ void UUINavWidget::InitialSetup(const bool bRebuilding)
 	else
 	{
 		SetupSelector();
-		UINavSetupWaitForTick = 0;
+		bPendingUINavSetup = true;
+		ScheduleDeferredUpdates();
 	}
 }
 
@@ -159,7 +230,8 @@ void UUINavWidget::ReconfigureSetup()
 	else
 	{
 		SetupSelector();
-		UINavSetupWaitForTick = 0;
+		bPendingUINavSetup = true;
+		ScheduleDeferredUpdates();
 	}
 
 	for (UUINavWidget* ChildUINavWidget : ChildUINavWidgets)
@@ -214,6 +286,278 @@ void UUINavWidget::TraverseHierarchy()
 	}
 }
 
+FUINavWidgetTopology* UUINavWidget::FindCachedTopology() const
+{
+	FUINavWidgetTopology* const Topology = CachedWidgetTopologies.Find(GetClass());
+	if (Topology == nullptr)
+	{
+		return nullptr;
+	}
+
+	//The widget blueprint was recompiled
+	if (IsTopologyStale(GetClass(), *Topology))
+	{
+		CachedWidgetTopologies.Remove(GetClass());
+		return nullptr;
+	}
+
+	return Topology;
+}
+
+bool UUINavWidget::ApplyCachedTopology(FUINavWidgetTopology& Topology)
+{
+	if (Topology.bDynamicTree)
+	{
+		return false;
+	}
+
+	//Widgets added to or removed from this instance's tree at design time are caught by their paths no longer resolving to the cached classes
+	auto ResolveCachedPath = [this, &Topology](const FUINavCachedWidgetPath& CachedPath) -> UWidget*
+	{
+		UWidget* const Widget = ResolveWidgetPath(CachedPath.Path);
+		if (Widget == nullptr || Widget->GetClass() != CachedPath.WidgetClass.Get())
+		{
+			Topology.bDynamicTree = true;
+			return nullptr;
+		}
+
+		return Widget;
+	};
+
+	TArray<UUINavWidget*> CachedChildUINavWidgets;
+	CachedChildUINavWidgets.Reserve(Topology.ChildUINavWidgetPaths.Num());
+	for (const FUINavCachedWidgetPath& CachedPath : Topology.ChildUINavWidgetPaths)
+	{
+		UUINavWidget* const ChildUINavWidget = Cast<UUINavWidget>(ResolveCachedPath(CachedPath));
+		if (ChildUINavWidget == nullptr)
+		{
+			return false;
+		}
+		CachedChildUINavWidgets.Add(ChildUINavWidget);
+	}
+
+	TArray<UButton*> CachedSectionButtons;
+	TArray<UWidget*> CachedSectionWidgets;
+	if (Topology.bHasSections)
+	{
+		CachedSectionButtons.Reserve(Topology.SectionButtonPaths.Num());
+		for (const FUINavCachedWidgetPath& CachedPath : Topology.SectionButtonPaths)
+		{
+			UButton* const SectionButton = Cast<UButton>(ResolveCachedPath(CachedPath));
+			if (SectionButton == nullptr)
+			{
+				return false;
+			}
+			CachedSectionButtons.Add(SectionButton);
+		}
+
+		CachedSectionWidgets.Reserve(Topology.SectionWidgetPaths.Num());
+		for (const FUINavCachedWidgetPath& CachedPath : Topology.SectionWidgetPaths)
+		{
+			UWidget* const SectionWidget = ResolveCachedPath(CachedPath);
+			if (SectionWidget == nullptr)
+			{
+				return false;
+			}
+			CachedSectionWidgets.Add(SectionWidget);
+		}
+	}
+
+	ChildUINavWidgets.Reset(CachedChildUINavWidgets.Num());
+	for (UUINavWidget* const ChildUINavWidget : CachedChildUINavWidgets)
+	{
+		ChildUINavWidget->AddParentToPath(ChildUINavWidgets.Num());
+		ChildUINavWidgets.Add(ChildUINavWidget);
+	}
+
+	SectionButtons = MoveTemp(CachedSectionButtons);
+	SectionWidgets = MoveTemp(CachedSectionWidgets);
+
+	if (!IsValid(FirstComponent) && !Topology.FirstComponentPath.IsEmpty())
+	{
+		UUINavComponent* const CachedFirstComponent = Cast<UUINavComponent>(ResolveWidgetPath(Topology.FirstComponentPath));
+		if (IsValid(CachedFirstComponent) && CachedFirstComponent->CanBeNavigated())
+		{
+			SetFirstComponent(CachedFirstComponent);
+		}
+	}
+
+	return true;
+}
+
+void UUINavWidget::CacheTopology() const
+{
+	const UWidgetTree* const WidgetTreeArchetype = GetWidgetTreeArchetype(GetClass());
+	if (WidgetTreeArchetype == nullptr)
+	{
+		return;
+	}
+
+	//Classes whose instances have different trees keep being traversed
+	const FUINavWidgetTopology* const ExistingTopology = CachedWidgetTopologies.Find(GetClass());
+	if (ExistingTopology != nullptr && ExistingTopology->bDynamicTree && !IsTopologyStale(GetClass(), *ExistingTopology))
+	{
+		return;
+	}
+
+	FUINavWidgetTopology Topology;
+	Topology.WidgetTreeArchetype = WidgetTreeArchetype;
+
+	//Widgets that don't belong to this widget's tree (e.g. named slot content) can't be resolved on other instances
+	auto AddCachedPath = [this](const UWidget* const Widget, TArray<FUINavCachedWidgetPath>& OutPaths) -> bool
+	{
+		TArray<FName> WidgetPath = GetWidgetPath(Widget);
+		if (WidgetPath.IsEmpty())
+		{
+			return false;
+		}
+
+		OutPaths.Add({ MoveTemp(WidgetPath), Widget->GetClass() });
+		return true;
+	};
+
+	Topology.ChildUINavWidgetPaths.Reserve(ChildUINavWidgets.Num());
+	for (const UUINavWidget* const ChildUINavWidget : ChildUINavWidgets)
+	{
+		if (!AddCachedPath(ChildUINavWidget, Topology.ChildUINavWidgetPaths))
+		{
+			return;
+		}
+	}
+
+	Topology.bHasSections = !SectionButtons.IsEmpty() || !SectionWidgets.IsEmpty();
+
+	Topology.SectionButtonPaths.Reserve(SectionButtons.Num());
+	for (const UButton* const SectionButton : SectionButtons)
+	{
+		if (!AddCachedPath(SectionButton, Topology.SectionButtonPaths))
+		{
+			return;
+		}
+	}
+
+	Topology.SectionWidgetPaths.Reserve(SectionWidgets.Num());
+	for (const UWidget* const SectionWidget : SectionWidgets)
+	{
+		if (!AddCachedPath(SectionWidget, Topology.SectionWidgetPaths))
+		{
+			return;
+		}
+	}
+
+	if (IsValid(FirstComponent))
+	{
+		Topology.FirstComponentPath = GetWidgetPath(FirstComponent);
+	}
+
+	//Entries are only added once per class and blueprint compilation, so this is when the ones of unloaded or recompiled classes are dropped
+	for (auto It = CachedWidgetTopologies.CreateIterator(); It; ++It)
+	{
+		if (IsTopologyStale(It->Key, It->Value))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	CachedWidgetTopologies.Add(GetClass(), MoveTemp(Topology));
+}
+
+TArray<FName> UUINavWidget::GetWidgetPath(const UWidget* const Widget) const
+{
+	TArray<FName> WidgetPath;
+
+	const UWidget* CurrentWidget = Widget;
+	while (IsValid(CurrentWidget))
+	{
+		WidgetPath.Insert(CurrentWidget->GetFName(), 0);
+
+		const UWidgetTree* const OuterWidgetTree = Cast<UWidgetTree>(CurrentWidget->GetOuter());
+		if (OuterWidgetTree == nullptr)
+		{
+			break;
+		}
+
+		if (OuterWidgetTree == WidgetTree)
+		{
+			return WidgetPath;
+		}
+
+		CurrentWidget = Cast<UUserWidget>(OuterWidgetTree->GetOuter());
+	}
+
+	return TArray<FName>();
+}
+
+UWidget* UUINavWidget::ResolveWidgetPath(const TArray<FName>& WidgetPath) const
+{
+	UWidgetTree* CurrentWidgetTree = WidgetTree;
+	UWidget* FoundWidget = nullptr;
+	for (int i = 0; i < WidgetPath.Num(); ++i)
+	{
+		if (CurrentWidgetTree == nullptr)
+		{
+			return nullptr;
+		}
+
+		FoundWidget = FindObjectFast<UWidget>(CurrentWidgetTree, WidgetPath[i]);
+		if (FoundWidget == nullptr)
+		{
+			return nullptr;
+		}
+
+		if (i < WidgetPath.Num() - 1)
+		{
+			const UUserWidget* const UserWidget = Cast<UUserWidget>(FoundWidget);
+			CurrentWidgetTree = UserWidget != nullptr ? UserWidget->WidgetTree : nullptr;
+		}
+	}
+
+	return FoundWidget;
+}
+
+void UUINavWidget::AddChildUINavWidget(UUINavWidget* ChildUINavWidget)
+{
+	if (!IsValid(ChildUINavWidget) || ChildUINavWidgets.Contains(ChildUINavWidget))
+	{
+		return;
+	}
+
+	//This widget may also have been constructed after its outer widget traversed its hierarchy, so it's connected up to the most outer widget first
+	if (IsValid(OuterUINavWidget) && OuterUINavWidget->bSetupStarted)
+	{
+		OuterUINavWidget->AddChildUINavWidget(this);
+	}
+
+	ChildUINavWidget->AddParentToPath(ChildUINavWidgets.Num());
+	for (int i = UINavWidgetPath.Num() - 1; i >= 0; --i)
+	{
+		ChildUINavWidget->AddParentToPath(UINavWidgetPath[i]);
+	}
+	ChildUINavWidgets.Add(ChildUINavWidget);
+
+	InvalidateSpatialIndex();
+}
+
+void UUINavWidget::RemoveChildUINavWidget(UUINavWidget* ChildUINavWidget)
+{
+	const int ChildIndex = ChildUINavWidgets.Find(ChildUINavWidget);
+	if (ChildIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	ChildUINavWidgets.RemoveAt(ChildIndex);
+	ChildUINavWidget->RemoveParentsFromPath(UINavWidgetPath.Num() + 1);
+
+	//The paths of the following children hold their index in this widget
+	for (int i = ChildIndex; i < ChildUINavWidgets.Num(); ++i)
+	{
+		ChildUINavWidgets[i]->SetIndexInPath(UINavWidgetPath.Num(), i);
+	}
+
+	InvalidateSpatialIndex();
+}
+
 void UUINavWidget::SetupSections()
 {
 	if (!IsValid(UINavSectionsPanel) && !IsValid(UINavSwitcher))
@@ -275,6 +619,24 @@ void UUINavWidget::SetupSections()
 		}
 	}
 
+	BindSectionButtons();
+
+	if (SectionWidgets.IsEmpty())
+	{
+		static const TArray<TSubclassOf<UWidget>> WidgetClassArray = { UUINavWidget::StaticClass(), UUINavComponent::StaticClass() };
+		for (UWidget* const ChildWidget : UINavSwitcher->GetAllChildren())
+		{
+			UWidget* TargetWidget = UUINavBlueprintFunctionLibrary::FindWidgetOfClassesInWidget(ChildWidget, WidgetClassArray);
+			if (IsValid(TargetWidget))
+			{
+				SectionWidgets.Add(TargetWidget);
+			}
+		}
+	}
+}
+
+void UUINavWidget::BindSectionButtons()
+{
 	for (int i = 0; i < SectionButtons.Num(); ++i)
 	{
 		switch (i)
@@ -311,19 +673,6 @@ void UUINavWidget::SetupSections()
 			break;
 		}
 	}
-
-	if (SectionWidgets.IsEmpty())
-	{
-		static const TArray<TSubclassOf<UWidget>> WidgetClassArray = { UUINavWidget::StaticClass(), UUINavComponent::StaticClass() };
-		for (UWidget* const ChildWidget : UINavSwitcher->GetAllChildren())
-		{
-			UWidget* TargetWidget = UUINavBlueprintFunctionLibrary::FindWidgetOfClassesInWidget(ChildWidget, WidgetClassArray);
-			if (IsValid(TargetWidget))
-			{
-				SectionWidgets.Add(TargetWidget);
-			}
-		}
-	}
 }
 
 void UUINavWidget::SetupSelector()
@@ -342,6 +691,8 @@ void UUINavWidget::SetupSelector()
 
 void UUINavWidget::UINavSetup()
 {
+	UINAV_SCOPE_STAT(STAT_UINavWidget_UINavSetup);
+
 	if (UINavPC == nullptr) return;
 
 	if (WidgetComp == nullptr)
@@ -390,6 +741,12 @@ void UUINavWidget::UINavSetup()
 	ReturnedFromWidget = nullptr;
 	IgnoreHoverComponent = nullptr;
 
+	if (SetupStartTime > 0.0)
+	{
+		UINavPC->RecordOpenLatency(FPlatformTime::Seconds() - SetupStartTime, GFrameCounter - SetupStartFrame);
+		SetupStartTime = 0.0;
+	}
+
 	PropagateOnSetupCompleted();
 }
 
@@ -583,15 +940,10 @@ bool UUINavWidget::IsNavigationKeyPressed(const EUINavigation NavigationEvent) c
 		return false;
 	}
 
-	TSharedRef<FUINavigationConfig> NavConfig = StaticCastSharedRef<FUINavigationConfig>(FSlateApplication::Get().GetNavigationConfig());
-	for (const TPair<FKey, EUINavigation>& KeyEventRule : NavConfig->KeyEventRules)
+	const TSharedRef<FUINavigationConfig> NavConfig = StaticCastSharedRef<FUINavigationConfig>(FSlateApplication::Get().GetNavigationConfig());
+	for (const FKey& Key : NavConfig->GetKeysForDirection(NavigationEvent))
 	{
-		if (KeyEventRule.Value != NavigationEvent)
-		{
-			continue;
-		}
-
-		if (UINavPC->GetPC()->IsInputKeyDown(KeyEventRule.Key))
+		if (UINavPC->GetPC()->IsInputKeyDown(Key))
 		{
 			return true;
 		}
@@ -607,15 +959,10 @@ bool UUINavWidget::IsNavigationKeyPressed(const EUINavigationAction NavigationAc
 		return false;
 	}
 
-	TSharedRef<FUINavigationConfig> NavConfig = StaticCastSharedRef<FUINavigationConfig>(FSlateApplication::Get().GetNavigationConfig());
-	for (const TPair<FKey, EUINavigationAction>& KeyEventRule : NavConfig->KeyActionRules)
+	const TSharedRef<FUINavigationConfig> NavConfig = StaticCastSharedRef<FUINavigationConfig>(FSlateApplication::Get().GetNavigationConfig());
+	for (const FKey& Key : NavConfig->GetKeysForAction(NavigationAction))
 	{
-		if (KeyEventRule.Value != NavigationAction)
-		{
-			continue;
-		}
-
-		if (UINavPC->GetPC()->IsInputKeyDown(KeyEventRule.Key))
+		if (UINavPC->GetPC()->IsInputKeyDown(Key))
 		{
 			return true;
 		}
@@ -638,49 +985,97 @@ FReply UUINavWidget::NativeOnKeyUp(const FGeometry& InGeometry, const FKeyEvent&
 	return Reply;
 }
 
-void UUINavWidget::NativeTick(const FGeometry & MyGeometry, float DeltaTime)
+void UUINavWidget::NativeDestruct()
+{
+	if (IsValid(UINavPC))
+	{
+		UINavPC->CancelWidgetUpdates(this);
+	}
+
+	bPendingUINavSetup = false;
+	bPendingSelectorUpdate = false;
+	bUpdateMousePositionNextFrame = false;
+	bMovingSelector = false;
+	MovementCounter = 0.f;
+	SetupStartTime = 0.0;
+
+	//This widget was removed from its outer widget's hierarchy, rather than the outer widget being removed
+	if (IsValid(OuterUINavWidget) && !OuterUINavWidget->IsBeingRemoved())
+	{
+		OuterUINavWidget->RemoveChildUINavWidget(this);
+	}
+
+	Super::NativeDestruct();
+}
+
+bool UUINavWidget::HasArrangedGeometry() const
+{
+	if (GetCachedGeometry().GetLocalSize().IsNearlyZero())
+	{
+		return false;
+	}
+
+	if (bPendingSelectorUpdate && IsValid(UpdateSelectorNextComponent) && IsValid(UpdateSelectorNextComponent->NavButton))
+	{
+		return !UpdateSelectorNextComponent->NavButton->GetCachedGeometry().GetLocalSize().IsNearlyZero();
+	}
+
+	return true;
+}
+
+bool UUINavWidget::ProcessDeferredUpdates()
 {
-	Super::NativeTick(MyGeometry, DeltaTime);
+	if (bPendingUINavSetup)
+	{
+		bPendingUINavSetup = false;
+		UINavSetup();
+	}
 
-	if (IsSelectorValid())
+	if (bPendingSelectorUpdate)
 	{
-		if (UINavSetupWaitForTick >= 0)
+		bPendingSelectorUpdate = false;
+		if (IsSelectorValid())
 		{
-			if (UINavSetupWaitForTick >= 1)
-			{
-				UINavSetup();
-				UINavSetupWaitForTick = -1;
-			}
-			else
-			{
-				UINavSetupWaitForTick++;
-			}
+			if (MoveCurve != nullptr) BeginSelectorMovement(UpdateSelectorPrevComponent, UpdateSelectorNextComponent);
+			else UpdateSelectorLocation(UpdateSelectorNextComponent);
 		}
+	}
 
-		if (UpdateSelectorWaitForTick >= 0)
+	if (bUpdateMousePositionNextFrame)
+	{
+		if (!IsValid(CurrentComponent) || !IsValid(CurrentComponent->NavButton))
 		{
-			if (UpdateSelectorWaitForTick >= 1)
-			{
-				if (MoveCurve != nullptr) BeginSelectorMovement(UpdateSelectorPrevComponent, UpdateSelectorNextComponent);
-				else UpdateSelectorLocation(UpdateSelectorNextComponent);
-				UpdateSelectorWaitForTick = -1;
-			}
-			else
-			{
-				UpdateSelectorWaitForTick++;
-			}
+			bUpdateMousePositionNextFrame = false;
 		}
-
-		if (bMovingSelector)
+		else if (!CurrentComponent->NavButton->GetCachedGeometry().GetLocalSize().IsNearlyZero())
 		{
-			HandleSelectorMovement(DeltaTime);
+			SetMousePositionToButton(CurrentComponent, GetDefault<UUINavSettings>()->MoveMouseToButtonPosition);
+			bUpdateMousePositionNextFrame = false;
 		}
 	}
 
-	if (bUpdateMousePositionNextFrame && !CurrentComponent->NavButton->GetCachedGeometry().GetLocalSize().IsNearlyZero())
+	return bUpdateMousePositionNextFrame;
+}
+
+bool UUINavWidget::TickSelectorMovement(const float DeltaTime)
+{
+	if (MoveCurve == nullptr)
 	{
-		SetMousePositionToButton(CurrentComponent, GetDefault<UUINavSettings>()->MoveMouseToButtonPosition);
-		bUpdateMousePositionNextFrame = false;
+		bMovingSelector = false;
+	}
+	else if (bMovingSelector)
+	{
+		HandleSelectorMovement(DeltaTime);
+	}
+
+	return bMovingSelector;
+}
+
+void UUINavWidget::ScheduleDeferredUpdates()
+{
+	if (IsValid(UINavPC))
+	{
+		UINavPC->ScheduleWidgetUpdate(this);
 	}
 }
 
@@ -853,6 +1248,18 @@ void UUINavWidget::HandleOnNavigation(FNavigationReply& Reply, UUINavWidget* Wid
 		return;
 	}
 
+	// Only the default Escape rule is replaced, so navigation rules set in the designer are kept
+	if (GetDefault<UUINavSettings>()->NavigationRoutingMode == ENavigationRoutingMode::SpatialIndex &&
+		Reply.GetBoundaryRule() == EUINavigationRule::Escape)
+	{
+		UUINavComponent* const TargetComponent = Widget->GetMostOuterUINavWidget()->FindSpatialNavigationTarget(Widget->GetCurrentComponent(), InNavigationEvent.GetNavigationType());
+		if (IsValid(TargetComponent) && TargetComponent->NavButton->GetCachedWidget().IsValid())
+		{
+			Reply = FNavigationReply::Explicit(TargetComponent->NavButton->GetCachedWidget());
+			return;
+		}
+	}
+
 	const bool bStopNextPrevious = GetDefault<UUINavSettings>()->bStopNextPreviousNavigation;
 	const bool bAllowsSectionInput = Widget->UINavPC->AllowsSectionInput();
 
@@ -1140,6 +1547,7 @@ void UUINavWidget::GoToSection(const int32 SectionIndex)
 	
 	const int32 OldIndex = UINavSwitcher->GetActiveWidgetIndex();
 	UINavSwitcher->SetActiveWidgetIndex(SectionIndex);
+	InvalidateSpatialIndex();
 	UWidget* TargetWidget = SectionWidgets[SectionIndex];
 	if (IsValid(TargetWidget))
 	{
@@ -1427,7 +1835,8 @@ void UUINavWidget::UpdateNavigationVisuals(UUINavComponent* Component, const boo
 	{
 		UpdateSelectorPrevComponent = CurrentComponent;
 		UpdateSelectorNextComponent = Component;
-		UpdateSelectorWaitForTick = 0;
+		bPendingSelectorUpdate = true;
+		ScheduleDeferredUpdates();
 	}
 
 	UpdateTextColor(Component);
@@ -1451,6 +1860,10 @@ void UUINavWidget::BeginSelectorMovement(UUINavComponent* FromComponent, UUINavC
 	MovementCounter = 0.0f;
 
 	bMovingSelector = true;
+	if (IsValid(UINavPC))
+	{
+		UINavPC->StartSelectorMovement(this);
+	}
 }
 
 void UUINavWidget::AttemptUnforceNavigation(const EInputType NewInputType)
@@ -1638,6 +2051,24 @@ UUINavWidget* UUINavWidget::GoToWidget(TSubclassOf<UUINavWidget> NewWidgetClass,
 	return GoToBuiltWidget(NewWidget, bRemoveParent, bDestroyParent, ZOrder);
 }
 
+UUINavWidget* UUINavWidget::GoToPooledWidget(TSubclassOf<UUINavWidget> NewWidgetClass, const bool bRemoveParent /*= true*/, const bool bDestroyParent, const int ZOrder)
+{
+	if (NewWidgetClass == nullptr)
+	{
+		DISPLAYERROR("GoToPooledWidget: No Widget Class found");
+		return nullptr;
+	}
+
+	if (!IsValid(UINavPC))
+	{
+		DISPLAYERROR("GoToPooledWidget: Widget doesn't have a valid UINavPC");
+		return nullptr;
+	}
+
+	UUINavWidget* NewWidget = UINavPC->AcquirePooledWidget(NewWidgetClass);
+	return GoToBuiltWidget(NewWidget, bRemoveParent, bDestroyParent, ZOrder);
+}
+
 UUINavWidget* UUINavWidget::GoToPromptWidget(TSubclassOf<UUINavPromptWidget> NewWidgetClass, const FPromptWidgetDecided& Event, const FText Title, const FText Message, const bool bRemoveParent /*= false*/, const int ZOrder /*= 0*/)
 {
 	if (NewWidgetClass == nullptr)
@@ -1742,6 +2173,7 @@ void UUINavWidget::ReturnToParent(const bool bRemoveAllParents, const int ZOrder
 			{
 				bReturningToParent = true;
 				RemoveFromParent();
+				TryReleaseToPool();
 			}
 		}
 		return;
@@ -1798,6 +2230,7 @@ void UUINavWidget::ReturnToParent(const bool bRemoveAllParents, const int ZOrder
 				}
 				bReturningToParent = true;
 				RemoveFromParent();
+				TryReleaseToPool();
 			}
 		}
 		else
@@ -1817,6 +2250,30 @@ void UUINavWidget::RemoveSelfAndAllParents()
 	}
 	bReturningToParent = true;
 	RemoveFromParent();
+	TryReleaseToPool();
+}
+
+void UUINavWidget::ResetForPool()
+{
+	CleanSetup();
+
+	ParentWidget = nullptr;
+	ReturnedFromWidget = nullptr;
+	bParentRemoved = false;
+	bShouldDestroyParent = false;
+	bReturningToParent = false;
+
+	SelectCount = 0;
+	SetSelectedComponent(nullptr);
+	SetHoveredComponent(nullptr);
+}
+
+void UUINavWidget::TryReleaseToPool()
+{
+	if (bPooled && IsValid(UINavPC))
+	{
+		UINavPC->ReleasePooledWidget(this);
+	}
 }
 
 int UUINavWidget::GetWidgetHierarchyDepth(UWidget* Widget) const
@@ -1835,6 +2292,8 @@ int UUINavWidget::GetWidgetHierarchyDepth(UWidget* Widget) const
 
 void UUINavWidget::NavigatedTo(UUINavComponent* NavigatedToComponent, const bool bNotifyUINavPC /*= true*/)
 {
+	UINAV_SCOPE_STAT(STAT_UINavWidget_NavigatedTo);
+
 	if (!IsValid(UINavPC) ||
 		(CurrentComponent == NavigatedToComponent && UINavPC->GetActiveSubWidget() == this))
 	{
@@ -1888,6 +2347,7 @@ void UUINavWidget::NavigatedTo(UUINavComponent* NavigatedToComponent, const bool
 	if (MouseRelativePosition != ESelectorPosition::None && UINavPC->GetCurrentInputType() != EInputType::Mouse)
 	{
 		bUpdateMousePositionNextFrame = true;
+		ScheduleDeferredUpdates();
 	}
 }
 
@@ -2045,6 +2505,29 @@ void UUINavWidget::AddParentToPath(const int IndexInParent)
 	}
 }
 
+void UUINavWidget::RemoveParentsFromPath(const int NumParents)
+{
+	UINavWidgetPath.RemoveAt(0, FMath::Min(NumParents, UINavWidgetPath.Num()));
+
+	for (UUINavWidget* ChildUINavWidget : ChildUINavWidgets)
+	{
+		ChildUINavWidget->RemoveParentsFromPath(NumParents);
+	}
+}
+
+void UUINavWidget::SetIndexInPath(const int Depth, const int Index)
+{
+	if (UINavWidgetPath.IsValidIndex(Depth))
+	{
+		UINavWidgetPath[Depth] = Index;
+	}
+
+	for (UUINavWidget* ChildUINavWidget : ChildUINavWidgets)
+	{
+		ChildUINavWidget->SetIndexInPath(Depth, Index);
+	}
+}
+
 void UUINavWidget::SetFirstComponent(UUINavComponent* Component)
 {
 	if (IsValid(FirstComponent))
@@ -2079,6 +2562,105 @@ void UUINavWidget::RemovedComponent(UUINavComponent* Component)
 	{
 		FirstComponent = nullptr;
 	}
+
+	if (NavComponents.Remove(Component) > 0)
+	{
+		InvalidateSpatialIndex();
+	}
+}
+
+void UUINavWidget::AddNavComponent(UUINavComponent* Component)
+{
+	if (!IsValid(Component))
+	{
+		return;
+	}
+
+	NavComponents.AddUnique(Component);
+	InvalidateSpatialIndex();
+}
+
+void UUINavWidget::InvalidateSpatialIndex()
+{
+	// The index is owned by the most outer UINavWidget, since it also covers the components of its child UINavWidgets
+	GetMostOuterUINavWidget()->SpatialIndex.MarkDirty();
+}
+
+static bool IsInActiveSwitcherSection(const UWidget* const Widget, const UUINavWidget* const OwnerWidget)
+{
+	const UWidget* CurrentWidget = Widget;
+	while (IsValid(CurrentWidget) && CurrentWidget != OwnerWidget)
+	{
+		const UPanelWidget* const ParentPanel = CurrentWidget->GetParent();
+		if (ParentPanel == nullptr)
+		{
+			CurrentWidget = UUINavWidget::GetOuterObject<UUserWidget>(CurrentWidget);
+			continue;
+		}
+
+		const UWidgetSwitcher* const ParentSwitcher = Cast<UWidgetSwitcher>(ParentPanel);
+		if (ParentSwitcher != nullptr && ParentSwitcher->GetActiveWidget() != CurrentWidget)
+		{
+			return false;
+		}
+
+		CurrentWidget = ParentPanel;
+	}
+
+	return true;
+}
+
+UUINavComponent* UUINavWidget::FindSpatialNavigationTarget(UUINavComponent* FromComponent, const EUINavigation Direction)
+{
+	if (!IsValid(FromComponent) ||
+		!IsValid(FromComponent->ParentWidget) ||
+		FromComponent->ParentWidget->GetMostOuterUINavWidget() != this ||
+		(Direction != EUINavigation::Left && Direction != EUINavigation::Right && Direction != EUINavigation::Up && Direction != EUINavigation::Down))
+	{
+		return nullptr;
+	}
+
+	auto RebuildSpatialIndex = [this]()
+	{
+		TArray<UUINavComponent*> IndexedComponents;
+		TArray<UUINavWidget*, TInlineAllocator<8>> WidgetsToIndex = { this };
+		while (WidgetsToIndex.Num() > 0)
+		{
+			UUINavWidget* const IndexedWidget = WidgetsToIndex.Pop(EAllowShrinking::No);
+			for (UUINavComponent* const Component : IndexedWidget->NavComponents)
+			{
+				// Components in inactive switcher sections keep stale geometry, so they can't be indexed
+				if (IsValid(Component) && IsInActiveSwitcherSection(Component, this))
+				{
+					IndexedComponents.Add(Component);
+				}
+			}
+
+			for (UUINavWidget* const ChildUINavWidget : IndexedWidget->ChildUINavWidgets)
+			{
+				if (IsValid(ChildUINavWidget))
+				{
+					WidgetsToIndex.Add(ChildUINavWidget);
+				}
+			}
+		}
+		SpatialIndex.Rebuild(IndexedComponents);
+	};
+
+	// The layout changed (e.g. scrolling or resizing) if the component being navigated from moved
+	if (SpatialIndex.NeedsRebuild() || !SpatialIndex.IsEntryUpToDate(FromComponent))
+	{
+		RebuildSpatialIndex();
+	}
+
+	UUINavComponent* TargetComponent = SpatialIndex.FindNearestInDirection(FromComponent, Direction);
+	if (IsValid(TargetComponent) && !SpatialIndex.IsEntryUpToDate(TargetComponent))
+	{
+		RebuildSpatialIndex();
+		TargetComponent = SpatialIndex.FindNearestInDirection(FromComponent, Direction);
+	}
+
+	return TargetComponent;
 }
 
 bool UUINavWidget::IsSelectorValid()
@@ -2,6 +2,11 @@
 
 #include "UINavigation.h"
 #include "Modules/ModuleManager.h"
+#include "UINavMacros.h"
+#include "UINavigationConfig.h"
+
+DEFINE_LOG_CATEGORY(LogUINavigation);
+LLM_DEFINE_TAG(UINavigation);
 
 #define LOCTEXT_NAMESPACE "FUINavigationModule"
 
@@ -14,6 +19,7 @@ void FUINavigationModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FUINavigationConfig::InvalidateCachedConfigs();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -5,6 +5,8 @@
 #include "Data/UINavEnhancedInputActions.h"
 #include "InputMappingContext.h"
 
+TMap<FUINavigationConfig::FCacheKey, TSharedRef<FUINavigationConfig>> FUINavigationConfig::CachedConfigs;
+
 FUINavigationConfig::FUINavigationConfig(const UInputMappingContext* const InputContext, const bool bAllowDirectionalInput /*= true*/, const bool bAllowSectionInput /*= true*/, const bool bAllowAccept /*= true*/, const bool bAllowBack /*= true*/, const bool bUseAnalogDirectionalInput /*= true*/, const bool bUsingThumbstickAsMouse /*= false*/)
 {
 	KeyEventRules.Reset();
@@ -17,6 +19,7 @@ FUINavigationConfig::FUINavigationConfig(const UInputMappingContext* const Input
 	const UUINavEnhancedInputActions* const InputActions = UINavSettings->EnhancedInputActions.LoadSynchronous();
 	if (InputActions == nullptr || InputContext == nullptr || !UINavSettings->bUseFocusSystemNavigationInputs)
 	{
+		BuildKeyIndices();
 		return;
 	}
 
@@ -72,6 +75,51 @@ FUINavigationConfig::FUINavigationConfig(const UInputMappingContext* const Input
 			KeyActionRules.Emplace(Mapping.Key, EUINavigationAction::Back);
 		}
 	}
+
+	BuildKeyIndices();
+}
+
+void FUINavigationConfig::BuildKeyIndices()
+{
+	for (const TPair<FKey, EUINavigation>& KeyEventRule : KeyEventRules)
+	{
+		if (KeyEventRule.Value < EUINavigation::Num)
+		{
+			DirectionKeys[static_cast<uint8>(KeyEventRule.Value)].Add(KeyEventRule.Key);
+		}
+	}
+
+	for (const TPair<FKey, EUINavigationAction>& KeyActionRule : KeyActionRules)
+	{
+		if (KeyActionRule.Value < EUINavigationAction::Num)
+		{
+			ActionKeys[static_cast<uint8>(KeyActionRule.Value)].Add(KeyActionRule.Key);
+		}
+	}
+}
+
+TSharedRef<FUINavigationConfig> FUINavigationConfig::GetOrCreate(const UInputMappingContext* const InputContext, const bool bAllowDirectionalInput /*= true*/, const bool bAllowSectionInput /*= true*/, const bool bAllowAccept /*= true*/, const bool bAllowBack /*= true*/, const bool bUseAnalogDirectionalInput /*= true*/, const bool bUsingThumbstickAsMouse /*= false*/)
+{
+	FCacheKey Key;
+	Key.InputContext = InputContext;
+	Key.Flags = static_cast<uint8>((bAllowDirectionalInput ? 1 << 0 : 0) |
+		(bAllowSectionInput ? 1 << 1 : 0) |
+		(bAllowAccept ? 1 << 2 : 0) |
+		(bAllowBack ? 1 << 3 : 0) |
+		(bUseAnalogDirectionalInput ? 1 << 4 : 0) |
+		(bUsingThumbstickAsMouse ? 1 << 5 : 0));
+
+	if (const TSharedRef<FUINavigationConfig>* const CachedConfig = CachedConfigs.Find(Key))
+	{
+		return *CachedConfig;
+	}
+
+	return CachedConfigs.Add(Key, MakeShared<FUINavigationConfig>(InputContext, bAllowDirectionalInput, bAllowSectionInput, bAllowAccept, bAllowBack, bUseAnalogDirectionalInput, bUsingThumbstickAsMouse));
+}
+
+void FUINavigationConfig::InvalidateCachedConfigs()
+{
+	CachedConfigs.Empty();
 }
 
 EUINavigationAction FUINavigationConfig::GetNavigationActionForKey(const FKey& InKey) const
@@ -114,15 +162,14 @@ EUINavigation FUINavigationConfig::GetNavigationDirectionFromAnalogKey(const FKe
 	return EUINavigation::Invalid;
 }
 
-TArray<FKey> FUINavigationConfig::GetKeysForDirection(const EUINavigation Direction) const
+const TArray<FKey>& FUINavigationConfig::GetKeysForDirection(const EUINavigation Direction) const
 {
-	TArray<FKey> DirectionsKeys;
-	for (const TPair<FKey, EUINavigation>& KeyEventRule : KeyEventRules)
-	{
-		if (KeyEventRule.Value == Direction)
-		{
-			DirectionsKeys.Add(KeyEventRule.Key);
-		}
-	}
-	return DirectionsKeys;
+	static const TArray<FKey> NoKeys;
+	return Direction < EUINavigation::Num ? DirectionKeys[static_cast<uint8>(Direction)] : NoKeys;
+}
+
+const TArray<FKey>& FUINavigationConfig::GetKeysForAction(const EUINavigationAction Action) const
+{
+	static const TArray<FKey> NoKeys;
+	return Action < EUINavigationAction::Num ? ActionKeys[static_cast<uint8>(Action)] : NoKeys;
 }
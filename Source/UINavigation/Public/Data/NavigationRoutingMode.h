@@ -0,0 +1,11 @@
+// Copyright (C) 2023 Gonçalo Marques - All Rights Reserved
+
+#pragma once
+#include "NavigationRoutingMode.generated.h"
+
+UENUM(BlueprintType, meta = (ScriptName = "UINavNavigationRoutingMode"))
+enum class ENavigationRoutingMode : uint8
+{
+	SlateFocus UMETA(DisplayName = "Slate Focus"),
+	SpatialIndex UMETA(DisplayName = "Spatial Index")
+};
@@ -0,0 +1,30 @@
+// Copyright (C) 2023 Gonçalo Marques - All Rights Reserved
+
+#pragma once
+#include "UINavOpenLatencyStats.generated.h"
+
+USTRUCT(BlueprintType)
+struct FUINavOpenLatencyStats
+{
+	GENERATED_BODY()
+
+	// Number of root UINavWidgets that finished their setup since the UINavPC began play
+	UPROPERTY(BlueprintReadOnly, Category = "UINavOpenLatency")
+	int32 NumSamples = 0;
+
+	// Time, in milliseconds, between the last root UINavWidget being constructed and it finishing its setup
+	UPROPERTY(BlueprintReadOnly, Category = "UINavOpenLatency")
+	float LastLatency = 0.0f;
+
+	// Number of frames between the last root UINavWidget being constructed and it finishing its setup
+	UPROPERTY(BlueprintReadOnly, Category = "UINavOpenLatency")
+	int32 LastLatencyFrames = 0;
+
+	// Average time, in milliseconds, between a root UINavWidget being constructed and it finishing its setup
+	UPROPERTY(BlueprintReadOnly, Category = "UINavOpenLatency")
+	float AverageLatency = 0.0f;
+
+	// Highest time, in milliseconds, between a root UINavWidget being constructed and it finishing its setup
+	UPROPERTY(BlueprintReadOnly, Category = "UINavOpenLatency")
+	float MaxLatency = 0.0f;
+};
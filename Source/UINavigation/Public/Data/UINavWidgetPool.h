@@ -0,0 +1,42 @@
+// Copyright (C) 2023 Gonçalo Marques - All Rights Reserved
+
+#pragma once
+#include "Containers/Array.h"
+#include "UINavWidgetPool.generated.h"
+
+class UUINavWidget;
+
+USTRUCT()
+struct FPooledUINavWidgets
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<UUINavWidget>> Widgets;
+};
+
+USTRUCT(BlueprintType)
+struct FUINavWidgetPoolStats
+{
+	GENERATED_BODY()
+
+	// Number of pooled widget requests that reused a pooled instance
+	UPROPERTY(BlueprintReadOnly, Category = "UINavWidgetPool")
+	int32 Hits = 0;
+
+	// Number of pooled widget requests that had to create a new instance
+	UPROPERTY(BlueprintReadOnly, Category = "UINavWidgetPool")
+	int32 Misses = 0;
+
+	// Number of instances that went back to the pool
+	UPROPERTY(BlueprintReadOnly, Category = "UINavWidgetPool")
+	int32 Released = 0;
+
+	// Number of instances that were thrown away because the pool was full
+	UPROPERTY(BlueprintReadOnly, Category = "UINavWidgetPool")
+	int32 Discarded = 0;
+
+	// Number of instances currently waiting in the pool
+	UPROPERTY(BlueprintReadOnly, Category = "UINavWidgetPool")
+	int32 NumPooled = 0;
+};
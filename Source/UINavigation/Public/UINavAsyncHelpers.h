@@ -92,12 +92,20 @@ public:
 	void execLoadUINavWidgetAsyncWithEvents(FFrame& Stack, RESULT_DECL);
 
 	
-	// 获取缓存统计信息
+	// 获取缓存统计信息，TotalCacheSize为字节数
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "UINav Async Widget", meta = (WorldContext = "WorldContext"))
 	static void GetCacheStatistics(
 		UObject* WorldContext,
 		int32& CachedWidgetClasses,
-		int32& TotalCacheSize
+		int64& TotalCacheSize
+	);
+
+	// 固定或取消固定Widget类，固定的类不会被缓存淘汰
+	UFUNCTION(BlueprintCallable, Category = "UINav Async Widget", meta = (WorldContext = "WorldContext"))
+	static void SetUINavWidgetClassPinned(
+		UObject* WorldContext,
+		TSoftClassPtr<UUINavWidget> WidgetClass,
+		bool bPinned = true
 	);
 
 	// 预加载Widget类
@@ -105,7 +113,8 @@ public:
 	static FGuid PreloadUINavWidgetClass(
 		UObject* WorldContext,
 		TSoftClassPtr<UUINavWidget> WidgetClass,
-		int32 Priority = 0
+		int32 Priority = 0,
+		bool bLoadDependencies = false
 	);
 
 	// 检查Widget类是否已缓存
@@ -119,7 +128,4 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "UINav Async Widget", meta = (WorldContext = "WorldContext"))
 	static UUINavAsyncWidgetManager* GetAsyncWidgetManager(UObject* WorldContext);
 
-protected:
-	// 获取异步Widget管理器的辅助函数
-	static UUINavAsyncWidgetManager* GetAsyncWidgetManager(UObject* WorldContext);
 };
\ No newline at end of file
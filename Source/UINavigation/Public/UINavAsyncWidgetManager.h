@@ -4,13 +4,38 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "Subsystems/GameInstanceSubsystem.h"
 #include "Engine/StreamableManager.h"
 #include "UINavWidget.h"
 #include "UINavAsyncWidgetManager.generated.h"
 
+class APlayerController;
+class ULocalPlayer;
+class FTimerManager;
+
 DECLARE_DYNAMIC_DELEGATE_OneParam(FOnWidgetLoaded, UUINavWidget*, LoadedWidget);
 DECLARE_DYNAMIC_DELEGATE_OneParam(FOnWidgetLoadFailed, const FString&, ErrorMessage);
 
+// Widget类缓存条目
+USTRUCT()
+struct FUINavCachedWidgetClass
+{
+	GENERATED_BODY()
+
+	// 加载的Widget类
+	UPROPERTY()
+	TSubclassOf<UUINavWidget> WidgetClass;
+
+	// 加载时使用的句柄，保持一同加载的依赖资源常驻
+	TSharedPtr<FStreamableHandle> Handle;
+
+	// Widget类及其依赖资源的大小（字节）
+	int64 ResourceBytes = 0;
+
+	// 最近一次使用的序号，用于LRU淘汰
+	uint64 LastAccess = 0;
+};
+
 USTRUCT(BlueprintType)
 struct FAsyncWidgetLoadRequest
 {
@@ -56,6 +81,21 @@ struct FAsyncWidgetLoadRequest
 	UPROPERTY(BlueprintReadOnly)
 	int32 Priority = 0;
 
+	// 发起请求的本地玩家，每个玩家有独立的等待队列
+	UPROPERTY()
+	TWeakObjectPtr<ULocalPlayer> OwningPlayer;
+
+	// 是否同时加载Widget类引用的资源 (贴图、字体、音效等)
+	UPROPERTY(BlueprintReadOnly)
+	bool bLoadDependencies = false;
+
+	// 是否只加载Widget类而不创建实例
+	UPROPERTY(BlueprintReadOnly)
+	bool bPreloadOnly = false;
+
+	// 入队序号，保证同优先级的请求先进先出
+	uint64 SequenceNumber = 0;
+
 	FAsyncWidgetLoadRequest()
 	{
 		RequestId = FGuid::NewGuid();
@@ -69,21 +109,31 @@ struct FAsyncWidgetLoadRequest
 		{
 			return Priority > Other.Priority;
 		}
-		return RequestTime < Other.RequestTime;
+		return SequenceNumber < Other.SequenceNumber;
 	}
 };
 
-UCLASS(BlueprintType, Blueprintable)
-class UINAVIGATION_API UUINavAsyncWidgetManager : public UObject
+/**
+ * 每个GameInstance一个的异步Widget加载管理器
+ * 每个本地玩家的请求在独立的队列中等待，并发槽位在玩家之间公平分配
+ */
+UCLASS(BlueprintType)
+class UINAVIGATION_API UUINavAsyncWidgetManager : public UGameInstanceSubsystem
 {
 	GENERATED_BODY()
 
 public:
 	UUINavAsyncWidgetManager();
 
-	// 获取全局单例
-	UFUNCTION(BlueprintCallable, Category = "UINav Async Widget", CallInEditor = true)
-	static UUINavAsyncWidgetManager* GetInstance(UObject* WorldContext = nullptr);
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// 获取WorldContext所属GameInstance的管理器
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "UINav Async Widget", meta = (WorldContext = "WorldContext"))
+	static UUINavAsyncWidgetManager* GetInstance(UObject* WorldContext);
+
+	// 获取WorldContext对应的玩家控制器 (玩家控制器本身、Widget的所属玩家或组件的所属Actor)
+	static APlayerController* FindPlayerController(const UObject* WorldContext);
 
 	// 异步加载并打开Widget
 	UFUNCTION(BlueprintCallable, Category = "UINav Async Widget")
@@ -94,7 +144,9 @@ public:
 		bool bRemoveParent = false,
 		bool bDestroyParent = false,
 		int32 ZOrder = 0,
-		int32 Priority = 0
+		int32 Priority = 0,
+		bool bLoadDependencies = false,
+		APlayerController* OwningPlayer = nullptr
 	);
 
 	// 取消异步加载请求
@@ -105,6 +157,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "UINav Async Widget")
 	void CancelAllLoadRequests();
 
+	// 取消某个玩家的所有异步加载请求，返回取消的数量
+	UFUNCTION(BlueprintCallable, Category = "UINav Async Widget")
+	int32 CancelPlayerLoadRequests(APlayerController* OwningPlayer);
+
 	// 获取当前正在加载的请求数量
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "UINav Async Widget")
 	int32 GetActiveLoadRequestCount() const;
@@ -125,22 +181,45 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "UINav Async Widget")
 	void SetLoadTimeout(float TimeoutSeconds);
 
+	// 设置加载依赖时的最大层级和最大字节数 (0表示不限制字节数)
+	UFUNCTION(BlueprintCallable, Category = "UINav Async Widget")
+	void SetDependencyLoadLimits(int32 MaxDepth, int64 MaxBytes);
+
+	// 获取请求加载的资源数量和磁盘大小（包括依赖），共享的加载会报告整个加载的大小
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "UINav Async Widget")
+	bool GetRequestLoadSize(const FGuid& RequestId, int32& NumAssets, int64& NumBytes) const;
+
 	// 获取请求状态
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "UINav Async Widget")
 	bool GetRequestStatus(const FGuid& RequestId, bool& bIsActive, bool& bIsPending, bool& bIsCancelled) const;
 
+	// 压力测试：对请求队列执行入队、取消一半、出队，并输出耗时（不会真正加载资源）
+	static void RunQueueBenchmark(UGameInstance* GameInstance, const int32 NumRequests);
+
 protected:
-	// 处理下一个等待中的请求
-	void ProcessNextRequest();
+	// 同一Widget类正在加载时共享该加载，否则加入等待队列
+	void SubmitRequest(FAsyncWidgetLoadRequest&& Request);
+
+	// 将请求加入等待队列
+	void EnqueueRequest(FAsyncWidgetLoadRequest&& Request);
+
+	// 在有空闲槽位时处理等待中的请求
+	void ProcessPendingRequests();
 
 	// 开始加载Widget
-	void StartLoadingWidget(const FAsyncWidgetLoadRequest& Request);
+	void StartLoadingWidget(const FGuid& RequestId);
 
-	// Widget加载完成回调
-	void OnWidgetClassLoaded(const FAsyncWidgetLoadRequest& Request);
+	// Widget加载完成回调，结果分发给共享这次加载的所有请求
+	void OnWidgetClassLoaded(const TSoftClassPtr<UUINavWidget> WidgetClass);
 
 	// 处理加载超时
-	void HandleLoadTimeout(const FGuid& RequestId);
+	void HandleLoadTimeout(const TSoftClassPtr<UUINavWidget> WidgetClass);
+
+	// 加载成功后创建Widget并回调
+	void CompleteRequest(const FAsyncWidgetLoadRequest& Request, TSubclassOf<UUINavWidget> LoadedClass);
+
+	// 回调加载失败
+	void FailRequest(const FAsyncWidgetLoadRequest& Request, const FString& ErrorMessage);
 
 	// 清理已完成或取消的请求
 	void CleanupCompletedRequests();
@@ -149,29 +228,116 @@ protected:
 	UUINavWidget* CreateAndSetupWidget(TSubclassOf<UUINavWidget> WidgetClass, const FAsyncWidgetLoadRequest& Request);
 
 private:
+	// 优先级堆中的条目
+	struct FPendingRequestEntry
+	{
+		FGuid RequestId;
+		int32 Priority = 0;
+		uint64 SequenceNumber = 0;
+	};
+
+	// 一个Widget类正在进行的加载，由所有请求该类的活跃请求共享
+	struct FInFlightWidgetLoad
+	{
+		TArray<FGuid> RequestIds;
+		TSharedPtr<FStreamableHandle> Handle;
+		FTimerHandle TimeoutHandle;
+		TWeakObjectPtr<ULocalPlayer> OwningPlayer;
+		int32 NumAssets = 0;
+		int64 NumBytes = 0;
+	};
+
+	// 已结束请求加载的资源数量和大小
+	struct FRequestLoadSize
+	{
+		int32 NumAssets = 0;
+		int64 NumBytes = 0;
+	};
+
+	// 从资源注册表按层级收集Widget类的依赖，返回收集到的包的磁盘大小
+	int64 GatherWidgetDependencies(const TSoftClassPtr<UUINavWidget>& WidgetClass, TArray<FSoftObjectPath>& OutAssetPaths) const;
+
+	// 将请求作为订阅者加入正在进行的加载，不占用并发槽位
+	void AttachToInFlightLoad(FInFlightWidgetLoad& InFlightLoad, FAsyncWidgetLoadRequest&& Request);
+
+	// 将活跃请求移出
+	bool RemoveActiveRequest(const FGuid& RequestId, FAsyncWidgetLoadRequest& OutRequest);
+
+	// 移除正在进行的加载，并清理其句柄和超时定时器
+	bool RemoveInFlightLoad(const TSoftClassPtr<UUINavWidget>& WidgetClass, FInFlightWidgetLoad& OutLoad, const bool bCancelHandle);
+
+	// 每个本地玩家的等待队列
+	struct FPlayerRequestQueue
+	{
+		// 优先级堆 (堆顶为优先级最高、最早入队的请求)
+		TArray<FPendingRequestEntry> Heap;
+
+		// 该玩家发起的正在进行的加载数量
+		int32 NumInFlightLoads = 0;
+
+		// 最近一次被调度的序号
+		uint64 LastServed = 0;
+	};
+
+	// 选择下一个要调度的玩家队列：不需要槽位的请求优先，其次是正在加载最少、最久未被调度的玩家
+	FPlayerRequestQueue* SelectNextPlayerQueue(const bool bHasFreeSlot);
+
+	// 取出玩家队列中优先级最高的等待请求
+	bool PopPendingRequest(FPlayerRequestQueue& Queue, FAsyncWidgetLoadRequest& OutRequest);
+
+	// 从玩家队列的优先级堆中移除指定位置的条目
+	void RemovePendingHeapEntry(TArray<FPendingRequestEntry>& Heap, const int32 HeapIndex);
+
+	void SiftPendingHeapUp(TArray<FPendingRequestEntry>& Heap, int32 HeapIndex);
+	void SiftPendingHeapDown(TArray<FPendingRequestEntry>& Heap, int32 HeapIndex);
+	void SwapPendingHeapEntries(TArray<FPendingRequestEntry>& Heap, const int32 IndexA, const int32 IndexB);
+
+	// 取消并移除等待中的请求
+	bool RemovePendingRequest(const FGuid& RequestId, FAsyncWidgetLoadRequest& OutRequest);
+
+	// GameInstance的定时器管理器，不属于GameInstance时为空
+	FTimerManager* GetTimerManager() const;
+
+	static bool IsHigherPriority(const FPendingRequestEntry& A, const FPendingRequestEntry& B);
+
+	void AddLoadingClass(const TSoftClassPtr<UUINavWidget>& WidgetClass);
+	void RemoveLoadingClass(const TSoftClassPtr<UUINavWidget>& WidgetClass);
+
 	// 流式管理器
-	UPROPERTY()
 	FStreamableManager StreamableManager;
 
 	// 当前正在执行的加载请求
 	UPROPERTY()
-	TArray<FAsyncWidgetLoadRequest> ActiveRequests;
+	TMap<FGuid, FAsyncWidgetLoadRequest> ActiveRequests;
 
 	// 等待队列中的请求
 	UPROPERTY()
-	TArray<FAsyncWidgetLoadRequest> PendingRequests;
+	TMap<FGuid, FAsyncWidgetLoadRequest> PendingRequests;
+
+	// 每个本地玩家的等待队列
+	TMap<TWeakObjectPtr<ULocalPlayer>, FPlayerRequestQueue> PlayerQueues;
+
+	// 请求ID到其在所属玩家优先级堆中位置的索引，用于O(log n)取消
+	TMap<FGuid, int32> PendingHeapIndices;
+
+	// 玩家队列调度计数器
+	uint64 PlayerServeCounter = 0;
+
+	// 每个Widget类正在加载或等待中的请求数量
+	TMap<TSoftClassPtr<UUINavWidget>, int32> LoadingClassCounts;
+
+	// 下一个入队序号
+	uint64 NextSequenceNumber = 0;
+
+	// 防止回调中重入处理等待队列
+	bool bProcessingRequests = false;
 
 	// 已取消的请求ID集合（用于快速查找）
 	UPROPERTY()
 	TSet<FGuid> CancelledRequestIds;
 
-	// 活跃的Streamable句柄
-	UPROPERTY()
-	TMap<FGuid, TSharedPtr<FStreamableHandle>> ActiveHandles;
-
-	// 超时定时器句柄
-	UPROPERTY()
-	TMap<FGuid, FTimerHandle> TimeoutHandles;
+	// 正在进行的加载，每个Widget类最多一个
+	TMap<TSoftClassPtr<UUINavWidget>, FInFlightWidgetLoad> InFlightLoads;
 
 	// 最大并发加载数量
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", meta = (AllowPrivateAccess = "true"))
@@ -185,15 +351,19 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", meta = (AllowPrivateAccess = "true"))
 	float CleanupInterval = 5.0f;
 
-	// 清理定时器句柄
-	FTimerHandle CleanupTimerHandle;
+	// 加载依赖时从Widget类开始的最大层级
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", meta = (AllowPrivateAccess = "true", ClampMin = 1))
+	int32 MaxDependencyDepth = 2;
 
-	// 全局实例
-	static UUINavAsyncWidgetManager* Instance;
+	// 加载依赖时每个Widget类最多加载的字节数 (0表示不限制)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", meta = (AllowPrivateAccess = "true", ClampMin = 0))
+	int64 MaxDependencyBytes = 0;
 
-	// World Context用于获取UI系统
-	UPROPERTY()
-	TWeakObjectPtr<UWorld> WorldContext;
+	// 已结束请求的加载大小，供GetRequestLoadSize查询
+	TMap<FGuid, FRequestLoadSize> FinishedLoadSizes;
+
+	// 清理定时器句柄
+	FTimerHandle CleanupTimerHandle;
 
 public:
 	// 调试功能：打印当前状态
@@ -204,21 +374,29 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "UINav Async Widget")
 	void GetLoadStatistics(int32& TotalRequests, int32& CompletedRequests, int32& FailedRequests, int32& CancelledRequests) const;
 
-	// 缓存管理功能
+	// 缓存管理功能，固定的Widget类会保留
 	UFUNCTION(BlueprintCallable, Category = "UINav Async Widget")
 	void ClearCache();
 
+	// 设置缓存的最大Widget类数量和最大字节数 (0表示不限制)，超出时按LRU淘汰
+	UFUNCTION(BlueprintCallable, Category = "UINav Async Widget")
+	void SetCacheLimits(int32 MaxEntries, int64 MaxBytes);
+
+	// 固定或取消固定Widget类，固定的类不会被淘汰 (可在加载前调用)
+	UFUNCTION(BlueprintCallable, Category = "UINav Async Widget")
+	void SetWidgetClassPinned(TSoftClassPtr<UUINavWidget> WidgetClass, bool bPinned);
+
 	// 预加载Widget类（不创建实例）
 	UFUNCTION(BlueprintCallable, Category = "UINav Async Widget")
-	FGuid PreloadWidgetClass(TSoftClassPtr<UUINavWidget> WidgetClass, int32 Priority = 0);
+	FGuid PreloadWidgetClass(TSoftClassPtr<UUINavWidget> WidgetClass, int32 Priority = 0, bool bLoadDependencies = false);
 
 	// 检查Widget类是否已缓存
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "UINav Async Widget")
 	bool IsWidgetClassCached(TSoftClassPtr<UUINavWidget> WidgetClass) const;
 
-	// 获取缓存统计信息
+	// 获取缓存统计信息，TotalCacheSize为缓存的Widget类及其依赖资源的大小（字节）
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "UINav Async Widget")
-	void GetCacheStatistics(int32& CachedWidgetClasses, int32& TotalCacheSize) const;
+	void GetCacheStatistics(int32& CachedWidgetClasses, int64& TotalCacheSize) const;
 
 private:
 	// 统计计数器
@@ -234,20 +412,44 @@ private:
 	UPROPERTY()
 	int32 CancelledRequestCount = 0;
 
+	// 共享了已有加载的请求数量
+	UPROPERTY()
+	int32 CoalescedRequestCount = 0;
+
 	// Widget类缓存
 	UPROPERTY()
-	TMap<TSoftClassPtr<UUINavWidget>, TSubclassOf<UUINavWidget>> WidgetClassCache;
+	TMap<TSoftClassPtr<UUINavWidget>, FUINavCachedWidgetClass> WidgetClassCache;
 
-	// 缓存的软引用，防止被垃圾回收
+	// 固定的Widget类，不会被淘汰
 	UPROPERTY()
-	TArray<TSharedPtr<FStreamableHandle>> CacheHandles;
+	TSet<TSoftClassPtr<UUINavWidget>> PinnedWidgetClasses;
+
+	// 缓存的最大Widget类数量 (0表示不限制)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", meta = (AllowPrivateAccess = "true", ClampMin = 0))
+	int32 MaxCachedWidgetClasses = 32;
+
+	// 缓存的最大字节数 (0表示不限制)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", meta = (AllowPrivateAccess = "true", ClampMin = 0))
+	int64 MaxCacheBytes = 0;
+
+	// 缓存中所有条目的大小（字节）
+	int64 CachedResourceBytes = 0;
+
+	// 缓存访问计数器
+	uint64 CacheAccessCounter = 0;
 
 	// 添加Widget类到缓存
-	void AddToWidgetClassCache(TSoftClassPtr<UUINavWidget> SoftClass, TSubclassOf<UUINavWidget> LoadedClass);
+	void AddToWidgetClassCache(TSoftClassPtr<UUINavWidget> SoftClass, TSubclassOf<UUINavWidget> LoadedClass, const TSharedPtr<FStreamableHandle>& Handle = nullptr);
+
+	// 从缓存获取Widget类，并标记为最近使用
+	TSubclassOf<UUINavWidget> GetFromWidgetClassCache(TSoftClassPtr<UUINavWidget> SoftClass);
+
+	// 从缓存移除Widget类并释放其句柄
+	void RemoveFromWidgetClassCache(const TSoftClassPtr<UUINavWidget>& SoftClass);
 
-	// 从缓存获取Widget类
-	TSubclassOf<UUINavWidget> GetFromWidgetClassCache(TSoftClassPtr<UUINavWidget> SoftClass) const;
+	// 按LRU淘汰未固定的Widget类，直到满足缓存上限
+	void TrimWidgetClassCache();
 
-	// 清理缓存句柄
-	void CleanupCacheHandles();
+	// 计算Widget类及句柄加载的资源大小
+	static int64 GetLoadedResourceBytes(UClass* LoadedClass, const TSharedPtr<FStreamableHandle>& Handle);
 };
\ No newline at end of file
@@ -113,6 +113,9 @@ public:
 	UPROPERTY()
 	class UUINavInputContainer* Container = nullptr;
 
+	// Index of this input box in the container's InputBoxes
+	int32 ContainerIndex = INDEX_NONE;
+
 	UPROPERTY(BlueprintReadOnly, Category = "Input")
 	FName InputName;
 	TArray<int> EnhancedInputGroups;
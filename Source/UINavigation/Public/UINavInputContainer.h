@@ -31,6 +31,19 @@ protected:
 
 	void SetupInputBoxes();
 	void CreateInputBoxes();
+	void BuildAxisScaleInputBoxes();
+
+	struct FInputBoxKeySlot
+	{
+		int32 InputBoxIndex;
+		int32 KeyIndex;
+	};
+
+	// The input boxes (and their key slots) using each key, sorted by input box and slot, used to find rebind collisions
+	TMap<FKey, TArray<FInputBoxKeySlot>> KeyOccupancy;
+
+	// The first input box of each action, axis and axis scale, used to find the input box with the opposite axis scale
+	TMap<TTuple<const UInputAction*, EInputAxis, EAxisType>, int32> AxisScaleInputBoxes;
 
 	UPROPERTY(BlueprintReadWrite, meta = (BindWidget), Category = "UINav Input")
 	class UPanelWidget* InputBoxesPanel = nullptr;
@@ -99,6 +112,9 @@ public:
 	UFUNCTION()
 	void SwapKeysDecided(const UPromptDataBase* const PromptData);
 
+	UFUNCTION()
+	void OnSavedInputContextsApplied();
+
 	UUINavInputBox* GetInputBoxInDirection(UUINavInputBox* InputBox, const EUINavigation Direction);
 	
 	UUINavInputBox* GetOppositeInputBox(const FInputContainerEnhancedActionData& ActionData);
@@ -108,6 +124,9 @@ public:
 
 	void GetEnhancedInputRebindData(const int InputIndex, FInputRebindData& RebindData) const;
 
+	// Called by the input boxes whenever one of their keys changes, to keep the key occupancy index up to date
+	void UpdateKeyOccupancy(const UUINavInputBox* const InputBox, const int KeyIndex, const FKey& OldKey, const FKey& NewKey);
+
 	//-----------------------------------------------------------------------
 
 	class UUINavPCComponent* UINavPC = nullptr;
@@ -16,6 +16,7 @@ class UImage;
 class UTextBlock;
 class URichTextBlock;
 class UUINavPCComponent;
+class UTexture2D;
 
 /**
  * 
@@ -41,6 +42,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "InputDisplay")
 	void SetIconSize(const FVector2D& NewSize);
 
+	// Displays the given key, using an icon and text already resolved by the UINavPC
+	void ApplyInputVisuals(const FKey& Key, const TSoftObjectPtr<UTexture2D>& NewSoftTexture, const FText& InputRawText);
+
+	UInputAction* GetInputAction() const { return InputAction; }
+	EInputAxis GetAxis() const { return Axis; }
+	EAxisType GetScale() const { return Scale; }
+	const FKey& GetDisplayedKey() const { return DisplayedKey; }
+
 	// Locks to a specific input type. If set to None, it is automatically detected
 	UPROPERTY(EditAnywhere, Category="InputDisplay")
 	EInputRestriction InputTypeRestriction = EInputRestriction::None;
@@ -70,6 +79,9 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "InputDisplay")
 	EInputDisplayType DisplayType = EInputDisplayType::Icon;
 
+	UFUNCTION()
+	void OnSavedInputContextsApplied();
+
 	UPROPERTY(EditAnywhere, Category = "InputDisplay")
 	bool bMatchIconSize = false;
 
@@ -94,6 +106,8 @@ protected:
 private:
 
 	UUINavPCComponent* UINavPC = nullptr;
+
+	FKey DisplayedKey;
 	
 };
  
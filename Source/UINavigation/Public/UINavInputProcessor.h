@@ -3,22 +3,71 @@
 #pragma once
 
 #include "Framework/Application/IInputProcessor.h"
+#include "Input/Events.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UUINavPCComponent;
+class SWindow;
 
 /**
-* 
+* Input processor shared by all local UINavPCs.
+* Each Slate event is dispatched only to the UINavPC whose local player owns the event's Slate user.
 */
 class UINAVIGATION_API FUINavInputProcessor : public IInputProcessor
 {
 
 protected:
-	class UUINavPCComponent* UINavPC = nullptr;
+	struct FRegisteredUINavPC
+	{
+		TWeakObjectPtr<UUINavPCComponent> UINavPC;
+
+		// The Slate user index of the UINavPC's local player, refreshed every tick
+		int32 SlateUserIndex = INDEX_NONE;
+
+		// The window of the UINavPC's game viewport, used when several UINavPCs share a Slate user. Refreshed every tick
+		TWeakPtr<SWindow> ViewportWindow;
+
+		// Latest event of each analog key received since the last tick
+		TMap<FKey, FAnalogInputEvent> PendingAnalogEvents;
+
+		// Amount of events dispatched to this UINavPC
+		uint64 NumInputEvents = 0;
+
+		// Amount of analog events that were replaced by a newer event of the same key before being processed
+		uint64 NumCoalescedAnalogEvents = 0;
+	};
+
+	TArray<FRegisteredUINavPC> RegisteredUINavPCs;
+
+	static TSharedPtr<FUINavInputProcessor> SharedInstance;
+
+	static int32 GetSlateUserIndex(const UUINavPCComponent* const UINavPC);
+
+	static TWeakPtr<SWindow> GetViewportWindow(const UUINavPCComponent* const UINavPC);
+
+	int32 FindRegisteredUINavPCIndex(const FSlateApplication& SlateApp, const int32 UserIndex) const;
+
+	/*
+	* Returns the UINavPC that should receive an event of the given Slate user, and counts the event.
+	* Calling into the UINavPC can register or unregister UINavPCs, so entries must be found again afterwards instead of being kept.
+	*/
+	UUINavPCComponent* GetEventTarget(const FSlateApplication& SlateApp, const int32 UserIndex);
+
+	FRegisteredUINavPC* FindRegisteredUINavPC(const UUINavPCComponent* const UINavPC);
+
+	const FRegisteredUINavPC* FindRegisteredUINavPC(const UUINavPCComponent* const UINavPC) const;
 
 public:
 
-	void SetUINavPC(UUINavPCComponent* NewUINavPC)
-	{
-		UINavPC = NewUINavPC;
-	}
+	// Registers the UINavPC with the shared processor, registering the processor with Slate if needed
+	static TSharedRef<FUINavInputProcessor> RegisterUINavPC(UUINavPCComponent* const UINavPC);
+
+	// Unregisters the UINavPC, unregistering the shared processor from Slate once no UINavPCs are left
+	static void UnregisterUINavPC(UUINavPCComponent* const UINavPC);
+
+	uint64 GetNumInputEvents(const UUINavPCComponent* const UINavPC) const;
+
+	uint64 GetNumCoalescedAnalogEvents(const UUINavPCComponent* const UINavPC) const;
 	
 	virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override;
 
@@ -35,4 +84,4 @@ public:
 	virtual bool HandleMouseButtonUpEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override;
 
 	virtual bool HandleMouseWheelOrGestureEvent(FSlateApplication& SlateApp, const FPointerEvent& InWheelEvent, const FPointerEvent* InGesture) override;
-};
+};
\ No newline at end of file
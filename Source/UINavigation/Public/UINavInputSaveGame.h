@@ -0,0 +1,31 @@
+// Copyright (C) 2023 Gonçalo Marques - All Rights Reserved
+
+#pragma once
+
+#include "GameFramework/SaveGame.h"
+#include "UINavInputSaveGame.generated.h"
+
+/**
+ * Save game used to store the player's input rebinds when bSaveInputsToSaveGame is enabled.
+ * Only the mappings that differ from the default input mappings are stored, as a compact binary diff.
+ */
+UCLASS()
+class UINAVIGATION_API UUINavInputSaveGame : public USaveGame
+{
+	GENERATED_BODY()
+
+public:
+	// Incremented whenever the layout of InputMappingsData changes
+	static constexpr int32 CurrentFormatVersion = 1;
+
+	UPROPERTY()
+	int32 FormatVersion = CurrentFormatVersion;
+
+	// The CurrentInputVersion of the UINavSettings when this save was written
+	UPROPERTY()
+	uint8 InputVersion = 0;
+
+	// The changed input mappings of each input context, relative to the default input mappings
+	UPROPERTY()
+	TArray<uint8> InputMappingsData;
+};
@@ -3,10 +3,18 @@
 #pragma once
 
 #include "Subsystems/LocalPlayerSubsystem.h"
+#include "Containers/Ticker.h"
+#include "Async/Future.h"
+#include "UObject/SoftObjectPath.h"
 #include "UINavLocalPlayerSubsystem.generated.h"
 
 class FSubsystemCollectionBase;
 class UInputMappingContext;
+class UUINavPCComponent;
+class USaveGame;
+struct FStreamableHandle;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FSavedInputContextsAppliedDelegate);
 
 /**
  * 
@@ -16,10 +24,108 @@ class UINAVIGATION_API UUINavLocalPlayerSubsystem : public ULocalPlayerSubsystem
 {
 	GENERATED_BODY()
 	
+protected:
+	// Input contexts whose mappings changed and still need to be written to the saved input settings
+	TSet<TWeakObjectPtr<UInputMappingContext>> DirtyInputContexts;
+
+	bool bPendingMappingsRebuild = false;
+
+	int32 InputRebindBatchDepth = 0;
+
+	double LastInputChangeTime = 0.0;
+
+	FTSTicker::FDelegateHandle PendingInputChangesHandle;
+
+	void SchedulePendingInputChanges();
+
+	bool TickPendingInputChanges(float DeltaTime);
+
+	void RebuildInputMappings();
+
+	void WriteSavedInputContexts(const bool bAsync = true);
+
+	UUINavPCComponent* GetUINavPC() const;
+
+	// The encoded changes of each input context relative to its default mappings, as stored in the input save game
+	TMap<FSoftObjectPath, TArray<uint8>> InputContextDeltas;
+
+	// Streams in the assets referenced by the saved input mappings, before they're applied
+	TSharedPtr<FStreamableHandle> SavedInputContextsHandle;
+
+	bool bSavedInputContextsApplied = false;
+
+	bool bInputSaveGameLoaded = false;
+
+	bool bLoadingInputSaveGame = false;
+
+	bool bWritingInputSaveGame = false;
+
+	bool bPendingInputSaveGameWrite = false;
+
+	// The async write of the input save game, so it can be waited for before the last save at shutdown
+	TFuture<bool> InputSaveGameWrite;
+
+	void LoadInputSaveGame();
+
+	void OnInputSaveGameLoaded(const FString& SlotName, const int32 UserIndex, USaveGame* SaveGame);
+
+	// Streams in the assets referenced by the saved input changes and applies them to their input contexts
+	void ApplyInputContextDeltas();
+
+	void WriteInputSaveGame(const bool bAsync = true);
+
+	void OnInputSaveGameWritten(const FString& SlotName, const int32 UserIndex, bool bSuccess);
+
+	int32 GetInputSaveGameUserIndex() const;
+
+	void ApplySavedInputMappings();
+
+	void FinishApplyingSavedInputContexts();
+
 public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 
+	virtual void Deinitialize() override;
+
+	// Marks the given input context to be saved. Saves are coalesced and written once no input context changed for InputSaveDelay seconds.
 	void SaveInputContextState(UInputMappingContext* InputContext);
-	
+
+	/*
+	*	Notifies that the mappings of the given input context were changed by a rebind.
+	*	The key caches are invalidated right away, the context is saved like in SaveInputContextState,
+	*	and the control mappings, navigation keys and input icons are refreshed once on the next frame.
+	*/
+	void NotifyInputContextChanged(UInputMappingContext* InputContext);
+
+	/*
+	*	Starts a batch of rebinds (e.g. a key swap). Until the matching EndInputRebindBatch is called,
+	*	the control mappings aren't rebuilt and nothing is saved, so the whole batch is applied and written at once.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "UINav Input")
+	void BeginInputRebindBatch();
+
+	UFUNCTION(BlueprintCallable, Category = "UINav Input")
+	void EndInputRebindBatch();
+
+	// Immediately rebuilds the control mappings and writes the saved input settings, if there are pending changes
+	UFUNCTION(BlueprintCallable, Category = "UINav Input")
+	void FlushPendingInputChanges();
+
+	/*
+	*	Applies the saved input mappings to their input contexts.
+	*	The input contexts and the assets their saved mappings reference are streamed in asynchronously first,
+	*	and SavedInputContextsAppliedDelegate is broadcast once they're applied.
+	*/
 	void ApplySavedInputContexts();
+
+	// Whether the saved input mappings were applied to their input contexts
+	UFUNCTION(BlueprintPure, Category = "UINav Input")
+	FORCEINLINE bool AreSavedInputContextsApplied() const { return bSavedInputContextsApplied; }
+
+	// Broadcast once the saved input mappings are applied. Widgets that read the input mappings should wait for this if AreSavedInputContextsApplied returns false.
+	UPROPERTY(BlueprintAssignable, Category = "UINav Input")
+	FSavedInputContextsAppliedDelegate SavedInputContextsAppliedDelegate;
+
+	// Discards the input changes stored in the input save game, after the input contexts were reset to their default mappings
+	void ResetSavedInputContexts();
 };
@@ -3,8 +3,19 @@
 #pragma once
 
 #include "Engine/Engine.h"
+#include "Stats/Stats.h"
+#include "HAL/LowLevelMemTracker.h"
+
+UINAVIGATION_API DECLARE_LOG_CATEGORY_EXTERN(LogUINavigation, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("UINavigation"), STATGROUP_UINavigation, STATCAT_Advanced);
+LLM_DECLARE_TAG_API(UINavigation, UINAVIGATION_API);
+
+// Times the enclosing scope under "stat UINavigation" and tracks the memory it allocates under the UINavigation LLM tag
+#define UINAV_SCOPE_STAT(Stat) SCOPE_CYCLE_COUNTER(Stat); LLM_SCOPE_BYTAG(UINavigation)
 
 #define DISPLAYERROR(Text) GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Red, FString::Printf(TEXT("%s"), *(FString(TEXT("Error in ")).Append(GetName()).Append(TEXT(": ")).Append(Text))))
 #define DISPLAYERROR_STATIC(Widget, Text) GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Red, FString::Printf(TEXT("%s"), *(FString(TEXT("Error in ")).Append(Widget->GetName()).Append(TEXT(": ")).Append(Text))))
 #define DISPLAYWARNING(Text) GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Orange, FString::Printf(TEXT("%s"), *(FString(TEXT("Warning in ")).Append(GetName()).Append(TEXT(": ")).Append(Text))))
+#define UINAV_LOG(Format, ...) UE_LOG(LogUINavigation, Log, TEXT(Format), ##__VA_ARGS__)
 #define IS_VR_PLATFORM !PLATFORM_SWITCH
@@ -21,12 +21,17 @@
 #include "Delegates/DelegateCombinations.h"
 #include "Misc/CoreMiscDefines.h"
 #include "UObject/SoftObjectPtr.h"
+#include "UObject/ObjectKey.h"
 #include "Data/PromptData.h"
+#include "Data/UINavWidgetPool.h"
+#include "Data/UINavOpenLatencyStats.h"
+#include "UINavAsyncWidgetManager.h"
 #include "UINavPCComponent.generated.h"
 
 class APlayerController;
 class FUINavInputProcessor;
 class UUINavInputBox;
+class UUINavInputDisplay;
 class UTexture2D;
 class UUINavWidget;
 class UUINavPromptWidget;
@@ -122,6 +127,70 @@ protected:
 	UPROPERTY()
 	TArray<const UInputMappingContext*> CachedInputContexts;
 
+	TSharedPtr<FStreamableHandle> CachedInputContextsHandle;
+
+	bool bPendingResetDefaultInputs = false;
+
+	struct FEnhancedInputKeyQuery
+	{
+		TObjectKey<UInputAction> Action;
+		EInputAxis Axis = EInputAxis::X;
+		EAxisType Scale = EAxisType::None;
+		EInputRestriction InputRestriction = EInputRestriction::None;
+
+		bool operator==(const FEnhancedInputKeyQuery& Other) const
+		{
+			return Action == Other.Action && Axis == Other.Axis && Scale == Other.Scale && InputRestriction == Other.InputRestriction;
+		}
+
+		friend uint32 GetTypeHash(const FEnhancedInputKeyQuery& Query)
+		{
+			return HashCombine(GetTypeHash(Query.Action), static_cast<uint32>(Query.Axis) | (static_cast<uint32>(Query.Scale) << 8) | (static_cast<uint32>(Query.InputRestriction) << 16));
+		}
+	};
+
+	// Resolved keys of GetEnhancedInputKey and GetEnhancedInputKeys, cleared whenever the mappings change
+	mutable TMap<FEnhancedInputKeyQuery, FKey> EnhancedInputKeyCache;
+	TMap<TObjectKey<UInputAction>, TArray<FKey>> EnhancedInputKeysCache;
+
+	struct FInputDisplayGroup
+	{
+		TArray<TWeakObjectPtr<UUINavInputDisplay>> Displays;
+		FKey Key;
+		TSoftObjectPtr<UTexture2D> Icon;
+		FText Text;
+	};
+
+	// Registered UINavInputDisplays, grouped by the input they display so that each input is only resolved once
+	TMap<FEnhancedInputKeyQuery, FInputDisplayGroup> InputDisplayGroups;
+
+	TSet<TWeakObjectPtr<UUINavInputDisplay>> PendingInputDisplayUpdates;
+
+	// UINavWidgets with steps waiting for their geometry to be arranged, and the frame in which they were scheduled
+	TMap<TWeakObjectPtr<UUINavWidget>, uint64> ScheduledWidgetUpdates;
+
+	FDelegateHandle SlatePostTickHandle;
+
+	// UINavWidgets whose selector is moving towards its new location
+	TArray<TWeakObjectPtr<UUINavWidget>> MovingSelectorWidgets;
+
+	struct FInputIconSet
+	{
+		TSharedPtr<FStreamableHandle> Handle;
+		int32 RefCount = 0;
+	};
+
+	// Icons of each input type's icon table, streamed in one batch and kept loaded while referenced
+	FInputIconSet GamepadIconSet;
+	FInputIconSet KeyboardMouseIconSet;
+
+	bool bAcquiredInputIconSet = false;
+	bool bPrefetchingGamepadIcons = false;
+
+	// Flattened rows of the current icon and name tables, rebuilt whenever those tables change
+	TMap<FKey, TSoftObjectPtr<UTexture2D>> KeyIconCache;
+	TMap<FKey, FText> KeyTextCache;
+
 	UPROPERTY()
 	TMap<const UInputMappingContext*, uint8> AddedInputContexts;
 
@@ -188,18 +257,76 @@ protected:
 
 	TArray<FKey> GamepadSelectKeys;
 
+	//Idle UINavWidget instances that can be reused by GoToPooledWidget
+	UPROPERTY()
+	TMap<TSubclassOf<UUINavWidget>, FPooledUINavWidgets> WidgetPool;
+
+	int32 NumPooledWidgets = 0;
+
+	FUINavWidgetPoolStats WidgetPoolStats;
+
+	FUINavOpenLatencyStats OpenLatencyStats;
+
 	/*************************************************************************/
 
 	void SetTimer(const EUINavigation NavigationDirection);
 
 	void CacheGameInputContexts();
 
+	void OnGameInputContextsLoaded();
+
+	// Returns the cached input contexts, waiting for them to finish loading if they're being loaded asynchronously
+	const TArray<const UInputMappingContext*>& GetGameInputContexts() const;
+
 	void TryResetDefaultInputs();
 
+	FKey FindEnhancedInputKey(const UInputAction* Action, const EInputAxis Axis, const EAxisType Scale, const EInputRestriction InputRestriction) const;
+
+	void FindEnhancedInputKeys(const UInputAction* Action, TArray<FKey>& OutKeys) const;
+
+	UFUNCTION()
+	void OnControlMappingsRebuilt();
+
+	/**
+	*	Whether the player's saved input mappings are still being applied, in which case the input displays are refreshed once they are
+	*/
+	bool WaitForSavedInputContexts();
+
+	UFUNCTION()
+	void OnSavedInputContextsApplied();
+
+	static FEnhancedInputKeyQuery GetInputDisplayQuery(const UUINavInputDisplay* const InputDisplay);
+
+	FInputIconSet& GetInputIconSet(const bool bGamepad) { return bGamepad ? GamepadIconSet : KeyboardMouseIconSet; }
+
+	const UDataTable* GetInputIconTable(const bool bGamepad) const;
+
+	void AcquireInputIconSet(const bool bGamepad);
+
+	void ReleaseInputIconSet(const bool bGamepad);
+
+	void StreamInputIconSet(const bool bGamepad);
+
+	void ReleaseAllInputIconSets();
+
+	void RebuildKeyDisplayCaches();
+
+	void ProcessPendingInputDisplayUpdates();
+
+	void OnSlatePostTick(const float DeltaTime);
+
+	void TickSelectorMovements(const float DeltaTime);
+
 	void InitPlatformData();
 
 	void ClearNavigationTimer();
 
+	// Enables the tick only while a navigation chain, the thumbstick cursor, the input cooldown or other per-frame work is pending
+	void UpdateComponentTickEnabled();
+
+	// Refreshes the navigation keys if whether a thumbstick is being used as mouse changed
+	void UpdateUsingThumbstickAsMouse();
+
 	/**
 	*	Returns the input type of the given key
 	*
@@ -434,7 +561,26 @@ public:
 	UFUNCTION(BlueprintCallable, Category = UINavController)
 	void ForceUpdateAllInputDisplays(const bool bOnlyTopLevel = false);
 
-	void SetIgnoreFocusByNavigation(const bool bIgnore) { bIgnoreFocusByNavigation = bIgnore; }
+	void RegisterInputDisplay(UUINavInputDisplay* const InputDisplay);
+	bool UnregisterInputDisplay(UUINavInputDisplay* const InputDisplay);
+
+	/*
+	*	Resolves the key, icon and text of each group of registered UINavInputDisplays and updates the displays showing a different key.
+	*	Updates are spread over several frames according to MaxInputDisplayUpdatesPerFrame.
+	*
+	*	@param bForceUpdate Whether to update every registered display, even if its key didn't change (e.g. when the icon tables change).
+	*/
+	void RefreshInputDisplays(const bool bForceUpdate = false);
+
+	// Runs the given UINavWidget's deferred steps after Slate arranges its geometry, at the latest on the next frame
+	void ScheduleWidgetUpdate(UUINavWidget* const UINavWidget);
+
+	// Moves the given UINavWidget's selector every frame until it reaches its destination
+	void StartSelectorMovement(UUINavWidget* const UINavWidget);
+
+	void CancelWidgetUpdates(UUINavWidget* const UINavWidget);
+
+	void SetIgnoreFocusByNavigation(const bool bIgnore);
 	bool IgnoreFocusByNavigation() const { return bIgnoreFocusByNavigation; }
 
 	void RequestRebuildMappings();
@@ -454,11 +600,18 @@ public:
 	void HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent);
 	void HandleKeyUpEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent);
 	void HandleAnalogInputEvent(FSlateApplication& SlateApp, const FAnalogInputEvent& InAnalogInputEvent);
+	// Applies the thumbstick as mouse and scrolling logic of the latest analog event of a key, once per tick
+	void ProcessAnalogInput(const FAnalogInputEvent& InAnalogInputEvent);
 	void HandleMouseMoveEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent);
 	void HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent);
 	void HandleMouseButtonUpEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent);
 	void HandleMouseWheelOrGestureEvent(FSlateApplication& SlateApp, const FPointerEvent& InWheelEvent, const FPointerEvent* InGesture);
 
+	// Amount of Slate input events routed to this UINavPC by the shared input processor
+	uint64 GetNumInputEvents() const;
+	// Amount of analog events routed to this UINavPC that were coalesced into a newer event of the same key
+	uint64 GetNumCoalescedAnalogEvents() const;
+
 	UFUNCTION(BlueprintCallable, Category = UINavController)
 	void SimulateMousePress();
 	UFUNCTION(BlueprintCallable, Category = UINavController)
@@ -555,6 +708,10 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = UINavController)
 	void GetEnhancedInputKeys(const UInputAction* Action, TArray<FKey>& OutKeys);
 
+	//Clears the keys cached by GetEnhancedInputKey and GetEnhancedInputKeys. Call this if you change input mappings without going through the UINavPC
+	UFUNCTION(BlueprintCallable, Category = UINavController)
+	void InvalidateEnhancedInputKeyCache();
+
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = UINavController)
 	UEnhancedInputComponent* GetEnhancedInputComponent() const;
 
@@ -600,6 +757,49 @@ public:
 	UFUNCTION(BlueprintCallable, Category = UINavController, meta = (AdvancedDisplay = 2, DeterminesOutputType = "NewWidgetClass"))
 	UUINavWidget* GoToBuiltWidget(UUINavWidget* NewWidget, const bool bRemoveParent, const bool bDestroyParent = false, const int ZOrder = 0);
 
+	/**
+	*	Adds given widget to screen, reusing an idle instance of that class from the widget pool if there's one.
+	*	The widget goes back to the pool once it's returned from or destroyed as a parent.
+	*
+	*	@param	NewWidgetClass  The class of the widget to add to the screen
+	*	@param	bRemoveParent  Whether to remove the parent widget (this widget) from the viewport
+	*	@param  bDestroyParent  Whether to destruct the parent widget (this widget)
+	*	@param  ZOrder Order to display the widget
+	*/
+	UFUNCTION(BlueprintCallable, Category = UINavController, meta = (AdvancedDisplay = 2, DeterminesOutputType = "NewWidgetClass"))
+	UUINavWidget* GoToPooledWidget(TSubclassOf<UUINavWidget> NewWidgetClass, const bool bRemoveParent, const bool bDestroyParent = false, const int ZOrder = 0);
+
+	/**
+	*	Returns an idle instance of the given class from the widget pool, or creates a new one if there's none
+	*/
+	UUINavWidget* AcquirePooledWidget(TSubclassOf<UUINavWidget> WidgetClass);
+
+	/**
+	*	Puts a widget obtained from the widget pool back into it, unless the pool limits were reached
+	*/
+	void ReleasePooledWidget(UUINavWidget* Widget);
+
+	/**
+	*	Creates instances of the given class and adds them to the widget pool, up to the pool limits
+	*
+	*	@param	WidgetClass  The class of the widgets to create
+	*	@param	Count  The amount of idle instances of that class to have in the pool
+	*/
+	UFUNCTION(BlueprintCallable, Category = UINavController)
+	void PrewarmWidgetPool(TSubclassOf<UUINavWidget> WidgetClass, const int32 Count = 1);
+
+	UFUNCTION(BlueprintCallable, Category = UINavController)
+	void ClearWidgetPool();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = UINavController)
+	FUINavWidgetPoolStats GetWidgetPoolStats() const;
+
+	// Records the time it took a root UINavWidget to go from being constructed to accepting navigation
+	void RecordOpenLatency(const double LatencySeconds, const uint64 LatencyFrames);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = UINavController)
+	FUINavOpenLatencyStats GetOpenLatencyStats() const { return OpenLatencyStats; }
+
 	UFUNCTION(BlueprintCallable, Category = UINavController, meta = (AdvancedDisplay = 1))
 	void NavigateInDirection(const EUINavigation Direction, const int32 UserIndex = 0);
 	void MenuNext();
@@ -666,7 +866,7 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = UINavController)
     FORCEINLINE bool IsMovingThumbstick() const { return ThumbstickDelta.X != 0.0f || ThumbstickDelta.Y != 0.0f; }
 
-.	// 异步加载并打开Widget (便捷方法)
+	// 异步加载并打开Widget (便捷方法)
 	UFUNCTION(BlueprintCallable, Category = UINavController)
 	FGuid GoToWidgetAsync(
 		TSoftClassPtr<UUINavWidget> WidgetClass,
@@ -8,7 +8,7 @@
 class UTextBlock;
 class URichTextBlock;
 
-UCLASS()
+UCLASS(meta = (DisableNativeTick))
 class UINAVIGATION_API UUINavPromptWidget : public UUINavWidget
 {
 	GENERATED_BODY()
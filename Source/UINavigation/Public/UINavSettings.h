@@ -8,6 +8,7 @@
 #include "Data/UINavEnhancedInputActions.h"
 #include "Data/PlatformConfigData.h"
 #include "Data/SelectorPosition.h"
+#include "Data/NavigationRoutingMode.h"
 #include "Math/MathFwd.h"
 #include "UINavSettings.generated.h"
 
@@ -67,6 +68,16 @@ public:
 	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	bool bIgnoreDisabledButton = true;
 
+	/*
+	* How directional navigation between UINavComponents of the same UINavWidget is resolved.
+	* Slate Focus uses Slate's default focus navigation, which checks the widget geometry of the hierarchy on every move.
+	* Spatial Index uses a grid built from the NavButton geometry of every UINavComponent in the most outer UINavWidget, including its child UINavWidgets,
+	* which is much cheaper for widgets with many components.
+	* Navigation rules set in the designer are kept, and navigation with no UINavComponent in that direction falls back to Slate Focus.
+	*/
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	ENavigationRoutingMode NavigationRoutingMode = ENavigationRoutingMode::SlateFocus;
+
 	// Whether to call the OnReturn event when you press or release the MenuReturn key
 	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	bool bReturnOnPress = false;
@@ -83,10 +94,44 @@ public:
 	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	bool bAllowFocusOnViewportInGameAndUI = false;
 
+	// The maximum amount of idle instances of each UINavWidget class kept by the UINavPC's widget pool
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Settings", meta = (ClampMin = 0))
+	int32 MaxPooledWidgetsPerClass = 2;
+
+	// The maximum amount of idle UINavWidget instances kept by the UINavPC's widget pool, across all classes
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Settings", meta = (ClampMin = 0))
+	int32 MaxPooledWidgets = 8;
+
 	// Whether to load the input icons asynchronously, in order to prevent Load Flushes
 	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	bool bLoadInputIconsAsync = false;
 
+	/*
+	* Whether the UINavPC should stream every icon of the current input type's icon table in a single batch, and keep them loaded while that input type is in use.
+	* The gamepad icons are also prefetched while a controller is connected, so switching between input types doesn't cause hitches or a burst of individual loads.
+	*/
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	bool bStreamInputIconSets = false;
+
+	// The maximum amount of UINavInputDisplays updated per frame when the input type or the input mappings change (0 for no limit)
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Settings", meta = (ClampMin = 0))
+	int32 MaxInputDisplayUpdatesPerFrame = 32;
+
+	// How long to wait, in seconds, after the last input rebind before writing the saved input mappings, so that consecutive rebinds are written together
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Settings", meta = (ClampMin = 0))
+	float InputSaveDelay = 1.0f;
+
+	/*
+	* Whether to save the player's input rebinds to a save game slot instead of the UINavigation config file.
+	* Only the mappings that differ from the default input mappings are saved, and the save is loaded and applied asynchronously.
+	*/
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	bool bSaveInputsToSaveGame = false;
+
+	// The name of the save game slot the input rebinds are saved to, when bSaveInputsToSaveGame is enabled
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Settings", meta = (EditCondition = "bSaveInputsToSaveGame"))
+	FString InputSaveGameSlotName = TEXT("UINavInputMappings");
+
 	// The amount of mouse movement delta that will trigger a rebind attempt when listening to a new key for input rebinding
 	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	float MouseMoveRebindThreshold = 2.0f;
@@ -137,6 +182,14 @@ public:
 	UPROPERTY(config, EditAnywhere, Category = "Settings")
 	TSoftObjectPtr<UInputMappingContext> EnhancedInputContext = TSoftObjectPtr<UInputMappingContext>(FSoftObjectPath("/UINavigation/Input/IC_UINav.IC_UINav"));
 
+	/*
+	* The input contexts that can be rebound and whose keys are used for input icons and texts.
+	* If empty, every input context in the project is found through the asset registry and loaded when the UINavPC begins play.
+	* If not empty, only these input contexts are loaded, asynchronously, and lookups that need them before they finish loading wait for them.
+	*/
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	TArray<TSoftObjectPtr<UInputMappingContext>> RebindableInputContexts;
+
 	UPROPERTY(config, EditAnywhere, Category = "Settings")
 	TSoftObjectPtr<UUINavEnhancedInputActions> EnhancedInputActions = TSoftObjectPtr<UUINavEnhancedInputActions>(FSoftObjectPath("/UINavigation/Input/UINavEnhancedInputActions.UINavEnhancedInputActions"));
 };
@@ -0,0 +1,72 @@
+// Copyright (C) 2023 Gonçalo Marques - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Layout/SlateRect.h"
+#include "Types/SlateEnums.h"
+
+class UUINavComponent;
+
+/**
+* Uniform grid of UINavComponents, built from their NavButton's cached geometry,
+* used to find the nearest navigable component in a given direction without going through Slate's hittest grid
+*/
+class UINAVIGATION_API FUINavSpatialIndex
+{
+public:
+
+	/**
+	*	Rebuilds the grid from the given components. Components without arranged geometry are skipped.
+	*/
+	void Rebuild(const TArray<UUINavComponent*>& Components);
+
+	void Reset();
+
+	FORCEINLINE void MarkDirty() { bDirty = true; }
+
+	/**
+	*	Whether the grid needs to be rebuilt before being queried
+	*/
+	bool NeedsRebuild() const;
+
+	/**
+	*	Whether the given component is in the grid with the same geometry it currently has
+	*/
+	bool IsEntryUpToDate(const UUINavComponent* Component) const;
+
+	/**
+	*	Returns the nearest navigable component in the given direction, or nullptr if there's none
+	*/
+	UUINavComponent* FindNearestInDirection(const UUINavComponent* FromComponent, const EUINavigation Direction) const;
+
+	FORCEINLINE int32 Num() const { return Entries.Num(); }
+
+	static FSlateRect GetComponentRect(const UUINavComponent* Component);
+
+private:
+
+	struct FEntry
+	{
+		TWeakObjectPtr<UUINavComponent> Component;
+		FSlateRect Rect;
+	};
+
+	FIntPoint GetCell(const FVector2D& Point) const;
+
+	TArray<FEntry> Entries;
+	TMap<const UUINavComponent*, int32> EntryIndices;
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	// The last query that visited each entry, so entries spanning several cells are only scored once per query
+	mutable TArray<uint32> EntryQueryStamps;
+	mutable uint32 QueryStamp = 0;
+
+	FIntPoint MinCell = FIntPoint::ZeroValue;
+	FIntPoint MaxCell = FIntPoint::ZeroValue;
+	float CellSize = 1.0f;
+
+	uint64 LastRebuildFrame = 0;
+	bool bDirty = true;
+	bool bHasSkippedComponents = false;
+};
@@ -13,6 +13,7 @@
 #include "Templates/SharedPointer.h"
 #include "Widgets/SWidget.h"
 #include "Slate/SObjectWidget.h"
+#include "UINavSpatialIndex.h"
 #include "UINavWidget.generated.h"
 
 class UUINavComponent;
@@ -26,11 +27,12 @@ class UButton;
 enum class EButtonStyle : uint8;
 enum class EUINavigation : uint8;
 enum class EUINavigationAction : uint8;
+struct FUINavWidgetTopology;
 
 /**
 * This class contains the logic for UserWidget navigation
 */
-UCLASS()
+UCLASS(meta = (DisableNativeTick))
 class UINAVIGATION_API UUINavWidget : public UUserWidget
 {
 	GENERATED_BODY()
@@ -46,8 +48,13 @@ protected:
 	UPROPERTY()
 	UUINavComponent* UpdateSelectorNextComponent = nullptr;
 	
-	int8 UINavSetupWaitForTick = -1;
-	int8 UpdateSelectorWaitForTick = -1;
+	//Steps deferred (through the UINavPC) until the widget's geometry has been arranged
+	bool bPendingUINavSetup = false;
+	bool bPendingSelectorUpdate = false;
+
+	//When and in which frame this root widget started its setup, used to measure how long it takes to become interactive
+	double SetupStartTime = 0.0;
+	uint64 SetupStartFrame = 0;
 
 	bool bReturningToParent = false;
 
@@ -92,6 +99,13 @@ protected:
 
 	bool bUsingSplitScreen = false;
 
+	//The UINavComponents whose ParentWidget is this widget
+	UPROPERTY()
+	TArray<UUINavComponent*> NavComponents;
+
+	//Only used by the most outer UINavWidget, and covers the components of its child UINavWidgets as well
+	FUINavSpatialIndex SpatialIndex;
+
 	/******************************************************************************/
 
 	UUINavWidget(const FObjectInitializer& ObjectInitializer);
@@ -263,6 +277,9 @@ public:
 	bool bCompletedSetup = false;
 	bool bSetupStarted = false;
 
+	//Whether this widget belongs to the UINavPC's widget pool and should go back to it when it's returned from
+	bool bPooled = false;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "UINavigation Selector")
 	UCurveFloat* MoveCurve = nullptr;
 
@@ -284,7 +301,7 @@ public:
 	virtual FReply NativeOnKeyDown(const FGeometry& InGeometry, const FKeyEvent& InKeyEvent) override;
 	virtual FReply NativeOnKeyUp(const FGeometry& InGeometry, const FKeyEvent& InKeyEvent) override;
 
-	virtual void NativeTick(const FGeometry & MyGeometry, float DeltaTime) override;
+	virtual void NativeDestruct() override;
 
 	virtual void RemoveFromParent() override;
 
@@ -328,6 +345,38 @@ public:
 
 	void SetupSections();
 
+	void BindSectionButtons();
+
+	/**
+	*	Returns the topology cached for this widget's class, if it's still valid
+	*/
+	FUINavWidgetTopology* FindCachedTopology() const;
+
+	/**
+	*	Fills the child UINavWidgets, sections and first component from a cached topology.
+	*	Returns false if a cached path doesn't resolve to a widget of the cached class in this instance, in which case the topology stops being used for its class.
+	*/
+	bool ApplyCachedTopology(FUINavWidgetTopology& Topology);
+
+	/**
+	*	Caches the topology found by TraverseHierarchy and SetupSections for this widget's class
+	*/
+	void CacheTopology() const;
+
+	TArray<FName> GetWidgetPath(const UWidget* const Widget) const;
+
+	UWidget* ResolveWidgetPath(const TArray<FName>& WidgetPath) const;
+
+	/**
+	*	Adds a child UINavWidget that was constructed after this widget's hierarchy was traversed
+	*/
+	void AddChildUINavWidget(UUINavWidget* ChildUINavWidget);
+
+	/**
+	*	Removes a child UINavWidget that was removed from this widget's hierarchy
+	*/
+	void RemoveChildUINavWidget(UUINavWidget* ChildUINavWidget);
+
 	/**
 	*	Reconfigures the blueprint if it has already been setup
 	*/
@@ -647,12 +696,30 @@ public:
 
 	void AddParentToPath(const int IndexInParent);
 
+	void RemoveParentsFromPath(const int NumParents);
+
+	void SetIndexInPath(const int Depth, const int Index);
+
 	UUINavComponent* GetFirstComponent() const { return FirstComponent; }
 
 	void SetFirstComponent(UUINavComponent* Component);
 
 	void RemovedComponent(UUINavComponent* Component);
 
+	void AddNavComponent(UUINavComponent* Component);
+
+	/**
+	*	Marks the spatial index as needing to be rebuilt before the next navigation (e.g. after changing the widget's layout)
+	*/
+	UFUNCTION(BlueprintCallable, Category = UINavWidget)
+	void InvalidateSpatialIndex();
+
+	/**
+	*	Returns the nearest navigable UINavComponent of this widget or its child UINavWidgets in the given direction, using the spatial index.
+	*	Should be called on the most outer UINavWidget.
+	*/
+	UUINavComponent* FindSpatialNavigationTarget(UUINavComponent* FromComponent, const EUINavigation Direction);
+
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = UINavWidget)
 	bool IsSelectorValid();
 
@@ -669,6 +736,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category = UINavWidget, meta = (AdvancedDisplay = 2, DeterminesOutputType="NewWidgetClass"))
 	UUINavWidget* GoToWidget(TSubclassOf<UUINavWidget> NewWidgetClass, const bool bRemoveParent = true, const bool bDestroyParent = false, const int ZOrder = 0);
 
+	/**
+	*	Adds given widget to screen, reusing an idle instance of that class from the UINavPC's widget pool if there's one
+	*
+	*	@param	NewWidgetClass  The class of the widget to add to the screen
+	*	@param	bRemoveParent  Whether to remove the parent widget (this widget) from the viewport
+	*	@param  bDestroyParent  Whether to destruct the parent widget (this widget)
+	*	@param  ZOrder Order to display the widget
+	*/
+	UFUNCTION(BlueprintCallable, Category = UINavWidget, meta = (AdvancedDisplay = 2, DeterminesOutputType = "NewWidgetClass"))
+	UUINavWidget* GoToPooledWidget(TSubclassOf<UUINavWidget> NewWidgetClass, const bool bRemoveParent = true, const bool bDestroyParent = false, const int ZOrder = 0);
+
 	/**
 	*	Adds given widget to screen (strongly recommended over manual alternative)
 	*
@@ -700,6 +778,33 @@ public:
 
 	void RemoveSelfAndAllParents();
 
+	/**
+	*	Clears the state tied to the previous use of this widget before it goes back to the widget pool
+	*/
+	void ResetForPool();
+
+	void TryReleaseToPool();
+
+	// Whether Slate has arranged this widget, and the button the selector is moving to, so the deferred steps can use their geometry
+	bool HasArrangedGeometry() const;
+
+	/**
+	*	Runs the steps that were deferred until the geometry was arranged. Called by the UINavPC.
+	*
+	*	@return Whether some step is still waiting (e.g. for the button's geometry) and should be retried next frame
+	*/
+	bool ProcessDeferredUpdates();
+
+	/**
+	*	Advances the selector's movement. Called by the UINavPC while the selector is moving.
+	*
+	*	@return Whether the selector is still moving
+	*/
+	bool TickSelectorMovement(const float DeltaTime);
+
+	// Asks the UINavPC to call ProcessDeferredUpdates once the geometry has been arranged
+	void ScheduleDeferredUpdates();
+
 	int GetWidgetHierarchyDepth(UWidget* Widget) const;
 
 	FORCEINLINE bool HasNavigation() const { return bHasNavigation; }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Framework/Application/NavigationConfig.h" // from Slate
+#include "UObject/ObjectKey.h"
 
 class UInputMappingContext;
 
@@ -11,13 +12,21 @@ class UINAVIGATION_API FUINavigationConfig : public FNavigationConfig
 public:
 	FUINavigationConfig(const UInputMappingContext* const InputContext, const bool bAllowDirectionalInput = true, const bool bAllowSectionInput = true, const bool bAllowAccept = true, const bool bAllowBack = true, const bool bUseAnalogDirectionalInput = true, const bool bUsingThumbstickAsMouse = false);
 
+	// Returns the config for the given parameters, only building a new one if there isn't one cached already
+	static TSharedRef<FUINavigationConfig> GetOrCreate(const UInputMappingContext* const InputContext, const bool bAllowDirectionalInput = true, const bool bAllowSectionInput = true, const bool bAllowAccept = true, const bool bAllowBack = true, const bool bUseAnalogDirectionalInput = true, const bool bUsingThumbstickAsMouse = false);
+
+	// Discards all cached configs. Must be called whenever the mappings of an input context change
+	static void InvalidateCachedConfigs();
+
 	virtual EUINavigationAction GetNavigationActionForKey(const FKey& InKey) const override;
 
 	virtual EUINavigation GetNavigationDirectionFromAnalog(const FAnalogInputEvent& InAnalogEvent) override;
 
 	EUINavigation GetNavigationDirectionFromAnalogKey(const FKeyEvent& InKeyEvent) const;
 
-	TArray<FKey> GetKeysForDirection(const EUINavigation Direction) const;
+	const TArray<FKey>& GetKeysForDirection(const EUINavigation Direction) const;
+
+	const TArray<FKey>& GetKeysForAction(const EUINavigationAction Action) const;
 
 	virtual bool IsAnalogHorizontalKey(const FKey& InKey) const override { return InKey == EKeys::Gamepad_LeftX || InKey == EKeys::Gamepad_RightX; }
 	virtual bool IsAnalogVerticalKey(const FKey& InKey) const override { return InKey == EKeys::Gamepad_LeftY || InKey == EKeys::Gamepad_RightY; }
@@ -25,4 +34,22 @@ public:
 	const TArray<FKey>& GetGamepadSelectKeys() const { return GamepadSelectKeys; }
 
 	TArray<FKey> GamepadSelectKeys;
+
+private:
+	void BuildKeyIndices();
+
+	// Reverse lookups of KeyEventRules and KeyActionRules, built once when the config is created
+	TArray<FKey> DirectionKeys[static_cast<uint8>(EUINavigation::Num)];
+	TArray<FKey> ActionKeys[static_cast<uint8>(EUINavigationAction::Num)];
+
+	struct FCacheKey
+	{
+		TObjectKey<UInputMappingContext> InputContext;
+		uint8 Flags = 0;
+
+		bool operator==(const FCacheKey& Other) const { return InputContext == Other.InputContext && Flags == Other.Flags; }
+		friend uint32 GetTypeHash(const FCacheKey& Key) { return HashCombine(GetTypeHash(Key.InputContext), Key.Flags); }
+	};
+
+	static TMap<FCacheKey, TSharedRef<FUINavigationConfig>> CachedConfigs;
 };
\ No newline at end of file
@@ -0,0 +1,246 @@
+// Copyright (C) 2023 Gonçalo Marques - All Rights Reserved
+
+#include "UINavBenchmarkUtils.h"
+#include "UINavBenchmarkWidgets.h"
+#include "UINavPCComponent.h"
+#include "UINavWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "InputAction.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UINavInputBenchmark
+{
+	// CanRegisterKey calls for each container size
+	static constexpr int32 NumKeyChecks = 1000;
+
+	// ForceUpdateAllInputDisplays calls for each amount of input displays
+	static constexpr int32 NumDisplayUpdates = 20;
+}
+
+/**
+* Builds a UINavInputContainer with the given amount of input boxes, each bound to a different key,
+* and measures UUINavInputContainer::CanRegisterKey with keys that collide with another input box.
+* Creates its own world and local player, so it runs on its own, including headless with -nullrhi.
+*/
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FUINavInputContainerBenchmarkTest, "UINavigation.Benchmark.InputContainer",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FUINavInputContainerBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	OutBeautifiedNames.Add(TEXT("Small"));
+	OutTestCommands.Add(TEXT("16"));
+
+	OutBeautifiedNames.Add(TEXT("Large"));
+	OutTestCommands.Add(TEXT("64"));
+}
+
+bool FUINavInputContainerBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace UINavInputBenchmark;
+
+	int32 NumInputBoxes = 0;
+	LexFromString(NumInputBoxes, *Parameters);
+	if (NumInputBoxes < 2)
+	{
+		AddError(FString::Printf(TEXT("Invalid benchmark parameters: %s"), *Parameters));
+		return false;
+	}
+
+	const TSharedRef<FUINavBenchmarkSession> Session = MakeShared<FUINavBenchmarkSession>();
+	if (!Session->IsValid())
+	{
+		AddError(TEXT("Failed to create the benchmark world and local player."));
+		return false;
+	}
+
+	UINavBenchmark::WaitForSession(*this, Session);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Session, NumInputBoxes]()
+	{
+		if (!Session->IsValid())
+		{
+			return true;
+		}
+
+		const TArray<UInputAction*> InputActions = UINavBenchmark::CreateInputActions(NumInputBoxes);
+		if (!Session->AddInputContext(InputActions))
+		{
+			AddError(FString::Printf(TEXT("Couldn't map %d input actions to different keyboard keys."), NumInputBoxes));
+			Session->Finish();
+			return true;
+		}
+
+		FInputContainerEnhancedActionDataArray ActionsData;
+		for (UInputAction* const InputAction : InputActions)
+		{
+			FInputContainerEnhancedActionData& ActionData = ActionsData.Actions.AddDefaulted_GetRef();
+			ActionData.Action = InputAction;
+		}
+
+		//Input components report an error outside of a UINavWidget, and that's also where containers are used
+		UUINavWidget* const HostWidget = CreateWidget<UUINavWidget>(Session->GetUINavPC()->GetPC(), UUINavWidget::StaticClass());
+		UUINavBenchmarkInputContainer* const Container = HostWidget->WidgetTree->ConstructWidget<UUINavBenchmarkInputContainer>(UUINavBenchmarkInputContainer::StaticClass());
+		HostWidget->WidgetTree->RootWidget = Container;
+		Container->InputBox_BP = UUINavBenchmarkInputBox::StaticClass();
+		Container->EnhancedInputs.Add(Session->GetInputContext(), ActionsData);
+
+		const FUINavBenchmarkTimer SetupTimer;
+		HostWidget->AddToViewport();
+		UINavBenchmark::ReportSample(*this, TEXT("InputContainer.AddToViewport"), SetupTimer.Stop(), 1);
+
+		if (Container->InputBoxes.Num() != NumInputBoxes || Container->GetNumKeyOccupancySlots() != NumInputBoxes)
+		{
+			AddError(FString::Printf(TEXT("Expected %d input boxes with a key each, got %d input boxes and %d keys."),
+				NumInputBoxes, Container->InputBoxes.Num(), Container->GetNumKeyOccupancySlots()));
+			HostWidget->RemoveFromParent();
+			Session->Finish();
+			return true;
+		}
+
+		int32 NumCollisions = 0;
+		const FUINavBenchmarkTimer Timer;
+		for (int32 i = 0; i < NumKeyChecks; ++i)
+		{
+			UUINavInputBox* const InputBox = Container->InputBoxes[i % NumInputBoxes];
+			const FKey CollidingKey = Container->InputBoxes[(i + 1) % NumInputBoxes]->GetKey(0);
+
+			int CollidingActionIndex = INDEX_NONE;
+			int CollidingKeyIndex = INDEX_NONE;
+			const ERevertRebindReason Result = Container->CanRegisterKey(InputBox, CollidingKey, /*bIsHold*/ false, /*Index*/ 0, CollidingActionIndex, CollidingKeyIndex);
+			NumCollisions += Result == ERevertRebindReason::UsedBySameInputGroup ? 1 : 0;
+		}
+		const FUINavBenchmarkSample Sample = Timer.Stop();
+
+		AddInfo(FString::Printf(TEXT("%d input boxes: %d of %d keys collided with another input box"), NumInputBoxes, NumCollisions, NumKeyChecks));
+		UINavBenchmark::ReportSample(*this, TEXT("InputContainer.CanRegisterKey"), Sample, NumKeyChecks);
+
+		if (NumCollisions != NumKeyChecks)
+		{
+			AddError(TEXT("Not every key collided with the input box it's bound to."));
+		}
+
+		HostWidget->RemoveFromParent();
+		Session->Finish();
+		return true;
+	}));
+
+	return true;
+}
+
+/**
+* Registers the given amount of input displays, spread across the given amount of input actions,
+* and measures UUINavPCComponent::ForceUpdateAllInputDisplays with and without the cached keys of those input actions.
+* Creates its own world and local player, so it runs on its own, including headless with -nullrhi.
+*/
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FUINavInputDisplaysBenchmarkTest, "UINavigation.Benchmark.InputDisplays",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FUINavInputDisplaysBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	OutBeautifiedNames.Add(TEXT("Small"));
+	OutTestCommands.Add(TEXT("64 8"));
+
+	OutBeautifiedNames.Add(TEXT("Medium"));
+	OutTestCommands.Add(TEXT("256 32"));
+
+	OutBeautifiedNames.Add(TEXT("Large"));
+	OutTestCommands.Add(TEXT("1024 64"));
+}
+
+bool FUINavInputDisplaysBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace UINavInputBenchmark;
+
+	TArray<FString> Values;
+	Parameters.ParseIntoArrayWS(Values);
+	int32 NumInputDisplays = 0;
+	int32 NumInputActions = 0;
+	if (Values.Num() == 2)
+	{
+		LexFromString(NumInputDisplays, *Values[0]);
+		LexFromString(NumInputActions, *Values[1]);
+	}
+
+	if (NumInputDisplays <= 0 || NumInputActions <= 0)
+	{
+		AddError(FString::Printf(TEXT("Invalid benchmark parameters: %s"), *Parameters));
+		return false;
+	}
+
+	const TSharedRef<FUINavBenchmarkSession> Session = MakeShared<FUINavBenchmarkSession>();
+	if (!Session->IsValid())
+	{
+		AddError(TEXT("Failed to create the benchmark world and local player."));
+		return false;
+	}
+
+	UINavBenchmark::WaitForSession(*this, Session);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Session, NumInputDisplays, NumInputActions]()
+	{
+		if (!Session->IsValid())
+		{
+			return true;
+		}
+
+		const TArray<UInputAction*> InputActions = UINavBenchmark::CreateInputActions(NumInputActions);
+		if (!Session->AddInputContext(InputActions))
+		{
+			AddError(FString::Printf(TEXT("Couldn't map %d input actions to different keyboard keys."), NumInputActions));
+			Session->Finish();
+			return true;
+		}
+
+		UUINavPCComponent* const UINavPC = Session->GetUINavPC();
+
+		TArray<UUINavInputDisplay*> InputDisplays;
+		InputDisplays.Reserve(NumInputDisplays);
+		for (int32 i = 0; i < NumInputDisplays; ++i)
+		{
+			UUINavInputDisplay* const InputDisplay = CreateWidget<UUINavBenchmarkInputDisplay>(UINavPC->GetPC(), UUINavBenchmarkInputDisplay::StaticClass());
+			InputDisplay->SetInputAction(InputActions[i % NumInputActions], EInputAxis::X, EAxisType::None);
+			InputDisplay->AddToViewport();
+			InputDisplays.Add(InputDisplay);
+		}
+
+		const int32 NumDisplayingKeys = InputDisplays.FilterByPredicate([](const UUINavInputDisplay* const InputDisplay) { return InputDisplay->GetDisplayedKey().IsValid(); }).Num();
+		if (NumDisplayingKeys != NumInputDisplays)
+		{
+			AddError(FString::Printf(TEXT("Only %d of %d input displays show a key."), NumDisplayingKeys, NumInputDisplays));
+		}
+
+		const FUINavBenchmarkTimer CachedTimer;
+		for (int32 i = 0; i < NumDisplayUpdates; ++i)
+		{
+			UINavPC->ForceUpdateAllInputDisplays();
+		}
+		const FUINavBenchmarkSample CachedSample = CachedTimer.Stop();
+
+		//Like after the mappings change, when every key is looked up again
+		const FUINavBenchmarkTimer UncachedTimer;
+		for (int32 i = 0; i < NumDisplayUpdates; ++i)
+		{
+			UINavPC->InvalidateEnhancedInputKeyCache();
+			UINavPC->ForceUpdateAllInputDisplays();
+		}
+		const FUINavBenchmarkSample UncachedSample = UncachedTimer.Stop();
+
+		AddInfo(FString::Printf(TEXT("%d input displays across %d input actions"), NumInputDisplays, NumInputActions));
+		UINavBenchmark::ReportSample(*this, TEXT("InputDisplays.ForceUpdate"), CachedSample, NumDisplayUpdates);
+		UINavBenchmark::ReportSample(*this, TEXT("InputDisplays.ForceUpdateUncached"), UncachedSample, NumDisplayUpdates);
+
+		for (UUINavInputDisplay* const InputDisplay : InputDisplays)
+		{
+			InputDisplay->RemoveFromParent();
+		}
+
+		Session->Finish();
+		return true;
+	}));
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,126 @@
+// Copyright (C) 2023 Gonçalo Marques - All Rights Reserved
+
+#include "UINavBenchmarkUtils.h"
+#include "UINavPCComponent.h"
+#include "UINavWidget.h"
+#include "UINavComponent.h"
+#include "Misc/App.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UINavNavigationBenchmark
+{
+	// Navigations done with each routing mode
+	static constexpr int32 NumNavigations = 200;
+
+	static const EUINavigation Directions[] = { EUINavigation::Right, EUINavigation::Down, EUINavigation::Left, EUINavigation::Up };
+}
+
+/**
+* Builds a synthetic UINavWidget tree and measures UUINavPCComponent::NavigateInDirection with each navigation routing mode.
+* Creates its own world and local player, so it runs on its own, including headless with -nullrhi.
+* The hot paths it goes through are also tracked under "stat UINavigation" and the UINavigation LLM tag.
+*/
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FUINavNavigationBenchmarkTest, "UINavigation.Benchmark.Navigation",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FUINavNavigationBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	UINavBenchmark::GetTreeSpecs(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FUINavNavigationBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace UINavNavigationBenchmark;
+
+	FUINavBenchmarkTreeSpec Spec;
+	if (!FUINavBenchmarkTreeSpec::Parse(Parameters, Spec))
+	{
+		AddError(FString::Printf(TEXT("Invalid benchmark parameters: %s"), *Parameters));
+		return false;
+	}
+
+	const TSharedRef<FUINavBenchmarkSession> Session = MakeShared<FUINavBenchmarkSession>();
+	if (!Session->IsValid())
+	{
+		AddError(TEXT("Failed to create the benchmark world and local player."));
+		return false;
+	}
+
+	UINavBenchmark::WaitForSession(*this, Session);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Session, Spec]()
+	{
+		if (Session->IsValid() && Session->AddWidget(Spec) == nullptr)
+		{
+			AddError(TEXT("Failed to create the benchmark widget."));
+			Session->Finish();
+		}
+		return true;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Session]()
+	{
+		Session->Tick(FApp::GetDeltaTime());
+		if (!Session->IsValid() || Session->IsWidgetReady())
+		{
+			return true;
+		}
+
+		if (++Session->NumFramesWaited > UINavBenchmark::MaxFramesToWait)
+		{
+			AddError(TEXT("The benchmark widget didn't complete its setup."));
+			Session->Finish();
+			return true;
+		}
+
+		return false;
+	}));
+
+	for (const ENavigationRoutingMode RoutingMode : { ENavigationRoutingMode::SlateFocus, ENavigationRoutingMode::SpatialIndex })
+	{
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Session, Spec, RoutingMode]()
+		{
+			UUINavPCComponent* const BenchmarkUINavPC = Session->GetUINavPC();
+			UUINavWidget* const Widget = Session->GetWidget();
+			if (!Session->IsWidgetReady())
+			{
+				return true;
+			}
+
+			Session->SetNavigationRoutingMode(RoutingMode);
+
+			int32 NumMoves = 0;
+			const FUINavBenchmarkTimer Timer;
+			for (int32 i = 0; i < NumNavigations; ++i)
+			{
+				const UUINavComponent* const PreviousComponent = Widget->GetCurrentComponent();
+				BenchmarkUINavPC->NavigateInDirection(Directions[(i / 2) % UE_ARRAY_COUNT(Directions)]);
+				NumMoves += Widget->GetCurrentComponent() != PreviousComponent ? 1 : 0;
+			}
+			const FUINavBenchmarkSample Sample = Timer.Stop();
+
+			const FString RoutingModeName = RoutingMode == ENavigationRoutingMode::SpatialIndex ? TEXT("SpatialIndex") : TEXT("SlateFocus");
+			UINavBenchmark::ReportSample(*this, FString::Printf(TEXT("Navigation.%s"), *RoutingModeName), Sample, NumNavigations);
+			AddInfo(FString::Printf(TEXT("%s with %s: %d of %d navigations moved to another component"), *RoutingModeName, *Spec.ToString(), NumMoves, NumNavigations));
+
+			if (NumMoves == 0)
+			{
+				AddError(FString::Printf(TEXT("No navigation moved to another component with %s"), *RoutingModeName));
+			}
+
+			return true;
+		}));
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Session]()
+	{
+		Session->Finish();
+		return true;
+	}));
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,92 @@
+// Copyright (C) 2023 Gonçalo Marques - All Rights Reserved
+
+#include "UINavBenchmarkUtils.h"
+#include "UINavPCComponent.h"
+#include "UINavWidget.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UINavSetupBenchmark
+{
+	// Widgets added and removed for each tree size
+	static constexpr int32 NumInstances = 8;
+}
+
+/**
+* Builds synthetic UINavWidget trees and measures adding them to the viewport, which constructs them and runs their UINavWidget setup.
+* Creates its own world and local player, so it runs on its own, including headless with -nullrhi.
+*/
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FUINavSetupBenchmarkTest, "UINavigation.Benchmark.Setup",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FUINavSetupBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	UINavBenchmark::GetTreeSpecs(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FUINavSetupBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace UINavSetupBenchmark;
+
+	FUINavBenchmarkTreeSpec Spec;
+	if (!FUINavBenchmarkTreeSpec::Parse(Parameters, Spec))
+	{
+		AddError(FString::Printf(TEXT("Invalid benchmark parameters: %s"), *Parameters));
+		return false;
+	}
+
+	const TSharedRef<FUINavBenchmarkSession> Session = MakeShared<FUINavBenchmarkSession>();
+	if (!Session->IsValid())
+	{
+		AddError(TEXT("Failed to create the benchmark world and local player."));
+		return false;
+	}
+
+	UINavBenchmark::WaitForSession(*this, Session);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Session, Spec]()
+	{
+		if (!Session->IsValid())
+		{
+			return true;
+		}
+
+		UUINavPCComponent* const UINavPC = Session->GetUINavPC();
+
+		FUINavBenchmarkSample BuildSample;
+		FUINavBenchmarkSample SetupSample;
+		for (int32 i = 0; i < NumInstances; ++i)
+		{
+			//Building the tree is the benchmark's own cost, so it's measured separately
+			const FUINavBenchmarkTimer BuildTimer;
+			UUINavWidget* const Widget = UINavBenchmark::CreateBenchmarkWidget(UINavPC, Spec);
+			BuildSample += BuildTimer.Stop();
+			if (Widget == nullptr)
+			{
+				AddError(TEXT("Failed to create the benchmark widget."));
+				Session->Finish();
+				return true;
+			}
+
+			const FUINavBenchmarkTimer SetupTimer;
+			Widget->AddToViewport();
+			SetupSample += SetupTimer.Stop();
+
+			TestTrue(TEXT("Widget started its setup when added to the viewport"), Widget->bSetupStarted || Widget->bCompletedSetup);
+
+			Widget->RemoveFromParent();
+		}
+
+		AddInfo(Spec.ToString());
+		UINavBenchmark::ReportSample(*this, TEXT("Setup.BuildTree"), BuildSample, NumInstances);
+		UINavBenchmark::ReportSample(*this, TEXT("Setup.AddToViewport"), SetupSample, NumInstances);
+
+		Session->Finish();
+		return true;
+	}));
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
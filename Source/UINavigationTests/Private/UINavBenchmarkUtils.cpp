@@ -0,0 +1,542 @@
+// Copyright (C) 2023 Gonçalo Marques - All Rights Reserved
+
+#include "UINavBenchmarkUtils.h"
+#include "UINavBenchmarkWidgets.h"
+#include "UINavController.h"
+#include "UINavPCComponent.h"
+#include "UINavWidget.h"
+#include "UINavComponent.h"
+#include "UINavLocalPlayerSubsystem.h"
+#include "UINavSettings.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/UniformGridPanel.h"
+#include "Components/UniformGridSlot.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "EnhancedInputSubsystems.h"
+#include "Framework/Application/SlateApplication.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTime.h"
+#include "InputAction.h"
+#include "InputMappingContext.h"
+#include "Misc/App.h"
+#include "Misc/AutomationTest.h"
+#include "Rendering/DrawElements.h"
+#include "Widgets/SOverlay.h"
+#include "Widgets/SVirtualWindow.h"
+
+namespace UINavBenchmark
+{
+	/**
+	*	Forwards everything to the allocator it replaces, counting the allocations made by the game thread
+	*/
+	class FAllocationCounter final : public FMalloc
+	{
+	public:
+
+		void Install()
+		{
+			if (GMalloc != nullptr && GMalloc != this)
+			{
+				InnerMalloc = GMalloc;
+				GMalloc = this;
+			}
+		}
+
+		// InnerMalloc is kept, since other threads might still be calling into this allocator
+		void Uninstall()
+		{
+			if (GMalloc == this)
+			{
+				GMalloc = InnerMalloc;
+			}
+		}
+
+		int64 GetNumAllocations() const { return NumAllocations; }
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override { CountAllocation(); return InnerMalloc->Malloc(Count, Alignment); }
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override { CountAllocation(); return InnerMalloc->TryMalloc(Count, Alignment); }
+		virtual void* MallocZeroed(SIZE_T Count, uint32 Alignment) override { CountAllocation(); return InnerMalloc->MallocZeroed(Count, Alignment); }
+		virtual void* TryMallocZeroed(SIZE_T Count, uint32 Alignment) override { CountAllocation(); return InnerMalloc->TryMallocZeroed(Count, Alignment); }
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override { if (Count > 0) CountAllocation(); return InnerMalloc->Realloc(Original, Count, Alignment); }
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override { if (Count > 0) CountAllocation(); return InnerMalloc->TryRealloc(Original, Count, Alignment); }
+		virtual void Free(void* Original) override { InnerMalloc->Free(Original); }
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return InnerMalloc->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return InnerMalloc->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { InnerMalloc->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { InnerMalloc->SetupTLSCachesOnCurrentThread(); }
+		virtual void MarkTLSCachesAsUsedOnCurrentThread() override { InnerMalloc->MarkTLSCachesAsUsedOnCurrentThread(); }
+		virtual void MarkTLSCachesAsUnusedOnCurrentThread() override { InnerMalloc->MarkTLSCachesAsUnusedOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void InitializeStatsMetadata() override { InnerMalloc->InitializeStatsMetadata(); }
+		virtual void UpdateStats() override { InnerMalloc->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { InnerMalloc->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { InnerMalloc->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return InnerMalloc->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return InnerMalloc->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("UINavBenchmarkAllocationCounter"); }
+
+	private:
+
+		void CountAllocation()
+		{
+			// Only the game thread writes the counter, so it doesn't need to be atomic
+			if (IsInGameThread())
+			{
+				++NumAllocations;
+			}
+		}
+
+		FMalloc* InnerMalloc = nullptr;
+		int64 NumAllocations = 0;
+	};
+
+	static FAllocationCounter AllocationCounter;
+
+	static UUINavInputBox* CreateInputBox(UWidgetTree* const OwnerWidgetTree)
+	{
+		return OwnerWidgetTree->ConstructWidget<UUINavBenchmarkInputBox>(UUINavBenchmarkInputBox::StaticClass());
+	}
+
+	static void AddToGrid(UUniformGridPanel* const Grid, UWidget* const Widget, const int32 CellIndex, const int32 NumColumns)
+	{
+		UUniformGridSlot* const GridSlot = Grid->AddChildToUniformGrid(Widget, CellIndex / NumColumns, CellIndex % NumColumns);
+		GridSlot->SetHorizontalAlignment(HAlign_Fill);
+		GridSlot->SetVerticalAlignment(VAlign_Fill);
+	}
+
+	static UUniformGridPanel* CreateGrid(UWidgetTree* const WidgetTree)
+	{
+		UUniformGridPanel* const Grid = WidgetTree->ConstructWidget<UUniformGridPanel>(UUniformGridPanel::StaticClass());
+		Grid->SetMinDesiredSlotWidth(64.0f);
+		Grid->SetMinDesiredSlotHeight(32.0f);
+		WidgetTree->RootWidget = Grid;
+		return Grid;
+	}
+
+	static int32 GetNumColumns(const int32 NumCells)
+	{
+		return FMath::Max(FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumCells))), 1);
+	}
+
+	static TArray<FKey> GetKeyboardKeys()
+	{
+		TArray<FKey> AllKeys;
+		EKeys::GetAllKeys(AllKeys);
+
+		TArray<FKey> KeyboardKeys;
+		for (const FKey& Key : AllKeys)
+		{
+			//Also skips the keys in UINavInputContainer's default blacklist
+			if (Key.GetMenuCategory() == EKeys::NAME_KeyboardCategory && !Key.IsModifierKey() && !Key.IsDeprecated() && Key != EKeys::Escape)
+			{
+				KeyboardKeys.Add(Key);
+			}
+		}
+
+		return KeyboardKeys;
+	}
+}
+
+bool FUINavBenchmarkTreeSpec::Parse(const FString& Parameters, FUINavBenchmarkTreeSpec& OutSpec)
+{
+	TArray<FString> Values;
+	Parameters.ParseIntoArrayWS(Values);
+	if (Values.Num() != 3)
+	{
+		return false;
+	}
+
+	LexFromString(OutSpec.NumComponents, *Values[0]);
+	LexFromString(OutSpec.NumChildWidgets, *Values[1]);
+	LexFromString(OutSpec.NumInputBoxes, *Values[2]);
+	return OutSpec.NumComponents > 0 && OutSpec.NumChildWidgets >= 0 && OutSpec.NumInputBoxes >= 0;
+}
+
+FString FUINavBenchmarkTreeSpec::ToString() const
+{
+	return FString::Printf(TEXT("%d components, %d child widgets, %d input boxes"), NumComponents, NumChildWidgets, NumInputBoxes);
+}
+
+FUINavBenchmarkSample& FUINavBenchmarkSample::operator+=(const FUINavBenchmarkSample& Other)
+{
+	Seconds += Other.Seconds;
+	NumAllocations += Other.NumAllocations;
+	return *this;
+}
+
+FUINavBenchmarkTimer::FUINavBenchmarkTimer()
+	: StartTime(FPlatformTime::Seconds())
+	, StartNumAllocations(UINavBenchmark::AllocationCounter.GetNumAllocations())
+{
+}
+
+FUINavBenchmarkSample FUINavBenchmarkTimer::Stop() const
+{
+	FUINavBenchmarkSample Sample;
+	Sample.Seconds = FPlatformTime::Seconds() - StartTime;
+	Sample.NumAllocations = UINavBenchmark::AllocationCounter.GetNumAllocations() - StartNumAllocations;
+	return Sample;
+}
+
+FUINavBenchmarkSession::FUINavBenchmarkSession()
+{
+	UUINavSettings* const UINavSettings = GetMutableDefault<UUINavSettings>();
+	PreviousRoutingMode = UINavSettings->NavigationRoutingMode;
+	PreviousInputCooldown = UINavSettings->WidgetTransitionInputCooldown;
+	PreviousMaxInputDisplayUpdates = UINavSettings->MaxInputDisplayUpdatesPerFrame;
+
+	//The cooldown would drop the navigations done right after the widget is shown
+	UINavSettings->WidgetTransitionInputCooldown = 0.0f;
+
+	//Input displays are measured updating all at once, instead of spread across frames
+	UINavSettings->MaxInputDisplayUpdatesPerFrame = 0;
+
+	UINavBenchmark::AllocationCounter.Install();
+
+	CreateWorld();
+}
+
+FUINavBenchmarkSession::~FUINavBenchmarkSession()
+{
+	Finish();
+}
+
+void FUINavBenchmarkSession::CreateWorld()
+{
+	if (GEngine == nullptr || !FSlateApplication::IsInitialized())
+	{
+		return;
+	}
+
+	GameInstance.Reset(NewObject<UGameInstance>(GEngine));
+	GameInstance->InitializeStandalone();
+
+	FWorldContext* const WorldContext = GameInstance->GetWorldContext();
+	UWorld* const World = GameInstance->GetWorld();
+	if (WorldContext == nullptr || World == nullptr)
+	{
+		return;
+	}
+
+	//Otherwise the project's default game mode would be spawned
+	World->GetWorldSettings()->DefaultGameMode = AGameModeBase::StaticClass();
+
+	//Virtual windows need no native window, so this works without a display
+	ViewportOverlay = SNew(SOverlay);
+	Window = SNew(SVirtualWindow).Size(FVector2D(1920.0f, 1080.0f));
+	Window->SetContent(ViewportOverlay.ToSharedRef());
+	FSlateApplication::Get().RegisterVirtualWindow(Window.ToSharedRef());
+
+	ViewportClient.Reset(NewObject<UGameViewportClient>(GEngine));
+	ViewportClient->Init(*WorldContext, GameInstance.Get(), /*bCreateNewAudioDevice*/ false);
+	ViewportClient->SetViewportOverlayWidget(Window, ViewportOverlay.ToSharedRef());
+	WorldContext->GameViewport = ViewportClient.Get();
+
+	FString Error;
+	LocalPlayer = GameInstance->CreateLocalPlayer(0, Error, /*bSpawnPlayerController*/ false);
+	if (!LocalPlayer.IsValid())
+	{
+		return;
+	}
+
+	World->InitializeActorsForPlay(FURL());
+
+	AUINavController* const PC = World->SpawnActor<AUINavController>();
+	if (PC == nullptr)
+	{
+		return;
+	}
+
+	PC->SetPlayer(LocalPlayer.Get());
+	UINavPC = PC->FindComponentByClass<UUINavPCComponent>();
+
+	//Dispatches BeginPlay to the PC, which applies the player's saved input mappings
+	World->BeginPlay();
+}
+
+void FUINavBenchmarkSession::DestroyWorld()
+{
+	UWorld* const World = GetWorld();
+	if (World != nullptr)
+	{
+		World->BeginTearingDown();
+		for (FActorIterator It(World); It; ++It)
+		{
+			It->RouteEndPlay(EEndPlayReason::Quit);
+		}
+	}
+
+	if (ViewportClient.IsValid())
+	{
+		ViewportClient->RemoveAllViewportWidgets();
+	}
+
+	if (GameInstance.IsValid())
+	{
+		if (FWorldContext* const WorldContext = GameInstance->GetWorldContext())
+		{
+			WorldContext->GameViewport = nullptr;
+		}
+
+		//Removes the local player, deinitializing its subsystems
+		GameInstance->Shutdown();
+	}
+
+	if (World != nullptr)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(/*bInformEngineOfWorld*/ false);
+	}
+
+	if (Window.IsValid() && FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().UnregisterVirtualWindow(Window.ToSharedRef());
+	}
+
+	Window.Reset();
+	ViewportOverlay.Reset();
+	InputContext.Reset();
+	ViewportClient.Reset();
+	GameInstance.Reset();
+	LocalPlayer.Reset();
+	UINavPC.Reset();
+}
+
+bool FUINavBenchmarkSession::IsValid() const
+{
+	return !bFinished && GetWorld() != nullptr && UINavPC.IsValid() && ::IsValid(UINavPC->GetPC());
+}
+
+bool FUINavBenchmarkSession::AreSavedInputContextsApplied() const
+{
+	const UUINavLocalPlayerSubsystem* const UINavLocalPlayerSubsystem = ULocalPlayer::GetSubsystem<UUINavLocalPlayerSubsystem>(LocalPlayer.Get());
+	return UINavLocalPlayerSubsystem == nullptr || UINavLocalPlayerSubsystem->AreSavedInputContextsApplied();
+}
+
+void FUINavBenchmarkSession::Tick(const float DeltaSeconds)
+{
+	if (!IsValid())
+	{
+		return;
+	}
+
+	//The game engine already ticks every game world, while the editor only ticks its own and PIE's
+	if (GIsEditor)
+	{
+		GetWorld()->Tick(LEVELTICK_All, DeltaSeconds);
+	}
+
+	//Virtual windows aren't drawn by Slate, and painting is what arranges the widgets and fills the hittest grid used for navigation
+	FSlateApplication& SlateApplication = FSlateApplication::Get();
+	Window->ProcessWindowInvalidation();
+	Window->SlatePrepass(SlateApplication.GetApplicationScale());
+	FSlateWindowElementList ElementList(Window);
+	Window->PaintWindow(SlateApplication.GetCurrentTime(), DeltaSeconds, ElementList, FWidgetStyle(), /*bParentEnabled*/ true);
+}
+
+UUINavWidget* FUINavBenchmarkSession::AddWidget(const FUINavBenchmarkTreeSpec& Spec)
+{
+	RemoveWidget();
+
+	UUINavWidget* const NewWidget = UINavBenchmark::CreateBenchmarkWidget(UINavPC.Get(), Spec);
+	if (NewWidget != nullptr)
+	{
+		NewWidget->AddToViewport();
+	}
+
+	Widget = NewWidget;
+	NumFramesWaited = 0;
+	return NewWidget;
+}
+
+void FUINavBenchmarkSession::RemoveWidget()
+{
+	if (Widget.IsValid())
+	{
+		Widget->RemoveFromParent();
+	}
+	Widget.Reset();
+}
+
+bool FUINavBenchmarkSession::IsWidgetReady() const
+{
+	return IsValid() &&
+		Widget.IsValid() &&
+		Widget->bCompletedSetup &&
+		!Widget->GetCachedGeometry().GetLocalSize().IsNearlyZero() &&
+		UINavPC->GetActiveWidget() == Widget.Get() &&
+		::IsValid(Widget->GetCurrentComponent());
+}
+
+void FUINavBenchmarkSession::SetNavigationRoutingMode(const ENavigationRoutingMode RoutingMode)
+{
+	GetMutableDefault<UUINavSettings>()->NavigationRoutingMode = RoutingMode;
+}
+
+bool FUINavBenchmarkSession::AddInputContext(const TArray<UInputAction*>& InputActions)
+{
+	UEnhancedInputLocalPlayerSubsystem* const EnhancedInputSubsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(LocalPlayer.Get());
+	const TArray<FKey> Keys = UINavBenchmark::GetKeyboardKeys();
+	if (EnhancedInputSubsystem == nullptr || Keys.Num() < InputActions.Num())
+	{
+		return false;
+	}
+
+	InputContext.Reset(NewObject<UInputMappingContext>(GetTransientPackage()));
+	for (int32 i = 0; i < InputActions.Num(); ++i)
+	{
+		InputContext->MapKey(InputActions[i], Keys[i]);
+	}
+
+	FModifyContextOptions Options;
+	Options.bForceImmediately = true;
+	EnhancedInputSubsystem->AddMappingContext(InputContext.Get(), /*Priority*/ 0, Options);
+	return true;
+}
+
+UWorld* FUINavBenchmarkSession::GetWorld() const
+{
+	return GameInstance.IsValid() ? GameInstance->GetWorld() : nullptr;
+}
+
+void FUINavBenchmarkSession::Finish()
+{
+	if (bFinished)
+	{
+		return;
+	}
+
+	RemoveWidget();
+	DestroyWorld();
+	bFinished = true;
+
+	UUINavSettings* const UINavSettings = GetMutableDefault<UUINavSettings>();
+	UINavSettings->NavigationRoutingMode = PreviousRoutingMode;
+	UINavSettings->WidgetTransitionInputCooldown = PreviousInputCooldown;
+	UINavSettings->MaxInputDisplayUpdatesPerFrame = PreviousMaxInputDisplayUpdates;
+
+	UINavBenchmark::AllocationCounter.Uninstall();
+}
+
+void UINavBenchmark::GetTreeSpecs(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands)
+{
+	OutBeautifiedNames.Add(TEXT("Small"));
+	OutTestCommands.Add(TEXT("16 2 4"));
+
+	OutBeautifiedNames.Add(TEXT("Medium"));
+	OutTestCommands.Add(TEXT("128 4 16"));
+
+	OutBeautifiedNames.Add(TEXT("Large"));
+	OutTestCommands.Add(TEXT("512 8 32"));
+}
+
+UUINavWidget* UINavBenchmark::CreateBenchmarkWidget(UUINavPCComponent* UINavPC, const FUINavBenchmarkTreeSpec& Spec)
+{
+	if (!IsValid(UINavPC) || !IsValid(UINavPC->GetPC()))
+	{
+		return nullptr;
+	}
+
+	UUINavWidget* const RootWidget = CreateWidget<UUINavWidget>(UINavPC->GetPC(), UUINavWidget::StaticClass());
+	if (RootWidget == nullptr)
+	{
+		return nullptr;
+	}
+
+	const int32 NumWidgets = Spec.NumChildWidgets + 1;
+	const int32 NumRootComponents = Spec.NumComponents - (Spec.NumComponents / NumWidgets) * Spec.NumChildWidgets;
+	const int32 NumRootCells = NumRootComponents + Spec.NumChildWidgets + Spec.NumInputBoxes;
+	const int32 NumRootColumns = GetNumColumns(NumRootCells);
+
+	UUniformGridPanel* const RootGrid = CreateGrid(RootWidget->WidgetTree);
+	int32 CellIndex = 0;
+
+	for (int32 i = 0; i < NumRootComponents; ++i)
+	{
+		AddToGrid(RootGrid, CreateComponent(RootWidget->WidgetTree, UUINavComponent::StaticClass()), CellIndex++, NumRootColumns);
+	}
+
+	for (int32 ChildIndex = 0; ChildIndex < Spec.NumChildWidgets; ++ChildIndex)
+	{
+		UUINavWidget* const ChildWidget = RootWidget->WidgetTree->ConstructWidget<UUINavWidget>(UUINavWidget::StaticClass());
+		const int32 NumChildComponents = Spec.NumComponents / NumWidgets;
+		const int32 NumChildColumns = GetNumColumns(NumChildComponents);
+
+		UUniformGridPanel* const ChildGrid = CreateGrid(ChildWidget->WidgetTree);
+		for (int32 i = 0; i < NumChildComponents; ++i)
+		{
+			AddToGrid(ChildGrid, CreateComponent(ChildWidget->WidgetTree, UUINavComponent::StaticClass()), i, NumChildColumns);
+		}
+
+		AddToGrid(RootGrid, ChildWidget, CellIndex++, NumRootColumns);
+	}
+
+	for (int32 i = 0; i < Spec.NumInputBoxes; ++i)
+	{
+		AddToGrid(RootGrid, CreateInputBox(RootWidget->WidgetTree), CellIndex++, NumRootColumns);
+	}
+
+	return RootWidget;
+}
+
+TArray<UInputAction*> UINavBenchmark::CreateInputActions(const int32 NumActions)
+{
+	TArray<UInputAction*> InputActions;
+	InputActions.Reserve(NumActions);
+	for (int32 i = 0; i < NumActions; ++i)
+	{
+		UInputAction* const InputAction = NewObject<UInputAction>(GetTransientPackage(), *FString::Printf(TEXT("IA_UINavBenchmark_%d"), i));
+		InputAction->ValueType = EInputActionValueType::Boolean;
+		InputActions.Add(InputAction);
+	}
+	return InputActions;
+}
+
+void UINavBenchmark::WaitForSession(FAutomationTestBase& Test, const TSharedRef<FUINavBenchmarkSession>& Session)
+{
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([&Test, Session]()
+	{
+		Session->Tick(FApp::GetDeltaTime());
+		if (!Session->IsValid() || Session->AreSavedInputContextsApplied())
+		{
+			Session->NumFramesWaited = 0;
+			return true;
+		}
+
+		if (++Session->NumFramesWaited > MaxFramesToWait)
+		{
+			Test.AddError(TEXT("The local player's saved input mappings were never applied."));
+			Session->Finish();
+			return true;
+		}
+
+		return false;
+	}));
+}
+
+void UINavBenchmark::ReportSample(FAutomationTestBase& Test, const FString& Name, const FUINavBenchmarkSample& Sample, const int32 NumIterations)
+{
+	const double MicrosecondsPerIteration = NumIterations > 0 ? Sample.Seconds * 1000000.0 / NumIterations : 0.0;
+	const double AllocationsPerIteration = NumIterations > 0 ? static_cast<double>(Sample.NumAllocations) / NumIterations : 0.0;
+
+	Test.AddInfo(FString::Printf(TEXT("%s: %.3f ms over %d iterations (%.2f us each), %lld game thread allocations (%.1f each)"),
+		*Name,
+		Sample.Seconds * 1000.0,
+		NumIterations,
+		MicrosecondsPerIteration,
+		Sample.NumAllocations,
+		AllocationsPerIteration));
+
+	Test.AddTelemetryData(Name + TEXT(".TotalMs"), Sample.Seconds * 1000.0);
+	Test.AddTelemetryData(Name + TEXT(".MicrosecondsPerIteration"), MicrosecondsPerIteration);
+	Test.AddTelemetryData(Name + TEXT(".Allocations"), static_cast<double>(Sample.NumAllocations));
+	Test.AddTelemetryData(Name + TEXT(".AllocationsPerIteration"), AllocationsPerIteration);
+}
@@ -0,0 +1,176 @@
+// Copyright (C) 2023 Gonçalo Marques - All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/NavigationRoutingMode.h"
+#include "UObject/StrongObjectPtr.h"
+
+class FAutomationTestBase;
+class SOverlay;
+class SVirtualWindow;
+class UGameInstance;
+class UGameViewportClient;
+class UInputAction;
+class UInputMappingContext;
+class ULocalPlayer;
+class UUINavPCComponent;
+class UUINavWidget;
+class UWorld;
+
+/**
+* The shape of a synthetic UINavWidget tree built for the benchmarks
+*/
+struct FUINavBenchmarkTreeSpec
+{
+	// UINavComponents spread evenly across the root UINavWidget and its child UINavWidgets
+	int32 NumComponents = 0;
+
+	// Child UINavWidgets nested in the root UINavWidget
+	int32 NumChildWidgets = 0;
+
+	// UINavInputBoxes in the root UINavWidget, each with 3 UINavInputComponents
+	int32 NumInputBoxes = 0;
+
+	static bool Parse(const FString& Parameters, FUINavBenchmarkTreeSpec& OutSpec);
+
+	FString ToString() const;
+};
+
+/**
+* Time taken and allocations made by a measured section of a benchmark
+*/
+struct FUINavBenchmarkSample
+{
+	double Seconds = 0.0;
+
+	// Allocations made by the game thread, counted while a FUINavBenchmarkSession is alive
+	int64 NumAllocations = 0;
+
+	FUINavBenchmarkSample& operator+=(const FUINavBenchmarkSample& Other);
+};
+
+class FUINavBenchmarkTimer
+{
+public:
+
+	FUINavBenchmarkTimer();
+
+	FUINavBenchmarkSample Stop() const;
+
+private:
+
+	double StartTime = 0.0;
+	int64 StartNumAllocations = 0;
+};
+
+/**
+* A game world of its own with a local player, an AUINavController and a viewport, so the benchmarks run without a game or PIE session,
+* including headless with -nullrhi. The viewport's widgets live in a virtual window that the session lays out and paints itself.
+* Also overrides the UINavSettings the benchmarks depend on and counts the game thread's allocations.
+* Everything is restored and destroyed when the session finishes.
+*/
+class FUINavBenchmarkSession
+{
+public:
+
+	FUINavBenchmarkSession();
+	~FUINavBenchmarkSession();
+
+	/**
+	*	Whether the world, local player and UINavPC were created
+	*/
+	bool IsValid() const;
+
+	/**
+	*	Whether the local player's saved input mappings were applied, which input displays and containers wait for
+	*/
+	bool AreSavedInputContextsApplied() const;
+
+	/**
+	*	Ticks the world and lays out and paints the viewport, so widgets have geometry and can be navigated
+	*/
+	void Tick(const float DeltaSeconds);
+
+	UUINavWidget* AddWidget(const FUINavBenchmarkTreeSpec& Spec);
+
+	void RemoveWidget();
+
+	/**
+	*	Whether the widget completed its setup and is the UINavPC's active widget, with a navigated component
+	*/
+	bool IsWidgetReady() const;
+
+	void SetNavigationRoutingMode(const ENavigationRoutingMode RoutingMode);
+
+	/**
+	*	Creates an input context mapping each of the given actions to a different keyboard key and adds it to the local player.
+	*	Returns false if there aren't enough keyboard keys.
+	*/
+	bool AddInputContext(const TArray<UInputAction*>& InputActions);
+
+	void Finish();
+
+	UUINavPCComponent* GetUINavPC() const { return UINavPC.Get(); }
+
+	UUINavWidget* GetWidget() const { return Widget.Get(); }
+
+	UWorld* GetWorld() const;
+
+	UInputMappingContext* GetInputContext() const { return InputContext.Get(); }
+
+	// Frames waited for the session or its widget to be ready, so a setup that never completes fails the test
+	int32 NumFramesWaited = 0;
+
+private:
+
+	void CreateWorld();
+
+	void DestroyWorld();
+
+	TStrongObjectPtr<UGameInstance> GameInstance;
+	TStrongObjectPtr<UGameViewportClient> ViewportClient;
+	TStrongObjectPtr<UInputMappingContext> InputContext;
+	TWeakObjectPtr<ULocalPlayer> LocalPlayer;
+	TWeakObjectPtr<UUINavPCComponent> UINavPC;
+	TWeakObjectPtr<UUINavWidget> Widget;
+
+	TSharedPtr<SVirtualWindow> Window;
+	TSharedPtr<SOverlay> ViewportOverlay;
+
+	ENavigationRoutingMode PreviousRoutingMode = ENavigationRoutingMode::SlateFocus;
+	float PreviousInputCooldown = 0.0f;
+	int32 PreviousMaxInputDisplayUpdates = 0;
+	bool bFinished = false;
+};
+
+namespace UINavBenchmark
+{
+	// The maximum amount of frames to wait for a benchmark session or widget to be ready
+	static constexpr int32 MaxFramesToWait = 300;
+
+	/**
+	*	Fills the test variants shared by the navigation and setup benchmarks, one per tree size
+	*/
+	void GetTreeSpecs(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands);
+
+	/**
+	*	Builds a UINavWidget with the given shape. Its components' NavButtons are created directly, so no widget blueprint is needed.
+	*/
+	UUINavWidget* CreateBenchmarkWidget(UUINavPCComponent* UINavPC, const FUINavBenchmarkTreeSpec& Spec);
+
+	/**
+	*	Creates transient boolean input actions
+	*/
+	TArray<UInputAction*> CreateInputActions(const int32 NumActions);
+
+	/**
+	*	Adds a latent command that ticks the session until it's ready, failing the test if it takes too long
+	*/
+	void WaitForSession(FAutomationTestBase& Test, const TSharedRef<FUINavBenchmarkSession>& Session);
+
+	/**
+	*	Adds the sample to the test's log and telemetry
+	*/
+	void ReportSample(FAutomationTestBase& Test, const FString& Name, const FUINavBenchmarkSample& Sample, const int32 NumIterations);
+}
@@ -0,0 +1,67 @@
+// Copyright (C) 2023 Gonçalo Marques - All Rights Reserved
+
+#include "UINavBenchmarkWidgets.h"
+#include "UINavComponent.h"
+#include "UINavInputComponent.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/Button.h"
+#include "Components/HorizontalBox.h"
+#include "Components/Image.h"
+#include "Components/VerticalBox.h"
+
+UUINavComponent* UINavBenchmark::CreateComponent(UWidgetTree* const OwnerWidgetTree, const TSubclassOf<UUINavComponent> ComponentClass)
+{
+	UUINavComponent* const Component = OwnerWidgetTree->ConstructWidget<UUINavComponent>(ComponentClass);
+	UButton* const NavButton = Component->WidgetTree->ConstructWidget<UButton>(UButton::StaticClass());
+	Component->WidgetTree->RootWidget = NavButton;
+	Component->NavButton = NavButton;
+
+	if (UUINavInputComponent* const InputComponent = Cast<UUINavInputComponent>(Component))
+	{
+		InputComponent->InputImage = InputComponent->WidgetTree->ConstructWidget<UImage>(UImage::StaticClass());
+		NavButton->AddChild(InputComponent->InputImage);
+	}
+
+	return Component;
+}
+
+void UUINavBenchmarkInputBox::NativeOnInitialized()
+{
+	UHorizontalBox* const InputButtonsBox = WidgetTree->ConstructWidget<UHorizontalBox>(UHorizontalBox::StaticClass());
+	WidgetTree->RootWidget = InputButtonsBox;
+
+	UUINavInputComponent** const NewInputButtons[] = { &InputButton1, &InputButton2, &InputButton3 };
+	for (UUINavInputComponent** const InputButton : NewInputButtons)
+	{
+		*InputButton = Cast<UUINavInputComponent>(UINavBenchmark::CreateComponent(WidgetTree, UUINavInputComponent::StaticClass()));
+		InputButtonsBox->AddChildToHorizontalBox(*InputButton);
+	}
+
+	Super::NativeOnInitialized();
+}
+
+int32 UUINavBenchmarkInputContainer::GetNumKeyOccupancySlots() const
+{
+	int32 NumSlots = 0;
+	for (const TPair<FKey, TArray<FInputBoxKeySlot>>& Entry : KeyOccupancy)
+	{
+		NumSlots += Entry.Value.Num();
+	}
+	return NumSlots;
+}
+
+void UUINavBenchmarkInputContainer::NativeOnInitialized()
+{
+	InputBoxesPanel = WidgetTree->ConstructWidget<UVerticalBox>(UVerticalBox::StaticClass());
+	WidgetTree->RootWidget = InputBoxesPanel;
+
+	Super::NativeOnInitialized();
+}
+
+void UUINavBenchmarkInputDisplay::NativeOnInitialized()
+{
+	InputImage = WidgetTree->ConstructWidget<UImage>(UImage::StaticClass());
+	WidgetTree->RootWidget = InputImage;
+
+	Super::NativeOnInitialized();
+}
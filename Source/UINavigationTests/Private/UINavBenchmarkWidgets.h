@@ -0,0 +1,62 @@
+// Copyright (C) 2023 Gonçalo Marques - All Rights Reserved
+
+#pragma once
+
+#include "UINavInputBox.h"
+#include "UINavInputContainer.h"
+#include "UINavInputDisplay.h"
+#include "UINavBenchmarkWidgets.generated.h"
+
+class UUINavComponent;
+class UWidgetTree;
+
+/**
+* Input box whose input components are created in C++, so the benchmarks don't need a widget blueprint
+*/
+UCLASS(NotBlueprintable, HideDropdown)
+class UUINavBenchmarkInputBox : public UUINavInputBox
+{
+	GENERATED_BODY()
+
+protected:
+
+	virtual void NativeOnInitialized() override;
+};
+
+/**
+* Input container whose input boxes panel is created in C++, so the benchmarks don't need a widget blueprint
+*/
+UCLASS(NotBlueprintable, HideDropdown)
+class UUINavBenchmarkInputContainer : public UUINavInputContainer
+{
+	GENERATED_BODY()
+
+public:
+
+	int32 GetNumKeyOccupancySlots() const;
+
+protected:
+
+	virtual void NativeOnInitialized() override;
+};
+
+/**
+* Input display whose input image is created in C++, so the benchmarks don't need a widget blueprint
+*/
+UCLASS(NotBlueprintable, HideDropdown)
+class UUINavBenchmarkInputDisplay : public UUINavInputDisplay
+{
+	GENERATED_BODY()
+
+protected:
+
+	virtual void NativeOnInitialized() override;
+};
+
+namespace UINavBenchmark
+{
+	/**
+	*	Creates a UINavComponent whose NavButton is created directly
+	*/
+	UUINavComponent* CreateComponent(UWidgetTree* const OwnerWidgetTree, const TSubclassOf<UUINavComponent> ComponentClass);
+}
@@ -0,0 +1,29 @@
+// Copyright (C) 2023 Gonçalo Marques - All Rights Reserved
+
+using UnrealBuildTool;
+using System.IO;
+
+public class UINavigationTests : ModuleRules
+{
+	public UINavigationTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Latest;
+		PrivateIncludePaths.Add(Path.Combine(ModuleDirectory, "Private"));
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"UMG",
+				"Slate",
+				"SlateCore",
+				"InputCore",
+				"EnhancedInput",
+				"UINavigation"
+			}
+			);
+	}
+}